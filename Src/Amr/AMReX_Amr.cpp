@@ -30,6 +30,8 @@
 #include <AMReX_FabSet.H>
 #include <AMReX_StateData.H>
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_FillPatchUtil.H>
+#include <AMReX_PhysBCFunct.H>
 #include <AMReX_Print.H>
 
 #ifdef BL_LAZY
@@ -332,6 +334,8 @@ Amr::InitAmr ()
     n_cycle.resize(nlev);
     dt_min.resize(nlev);
     amr_level.resize(nlev);
+    measured_cost.resize(nlev);
+    measured_step_cost.resize(nlev);
     //
     // Set bogus values.
     //
@@ -500,6 +504,39 @@ Amr::InitAmr ()
 
     loadbalance_max_fac = 1.5;
     pp.query("loadbalance_max_fac", loadbalance_max_fac);
+
+    regrid_move_unchanged = 0;
+    pp.query("regrid_move_unchanged", regrid_move_unchanged);
+
+    loadbalance_with_measured_cost = 0;
+    pp.query("loadbalance_with_measured_cost", loadbalance_with_measured_cost);
+
+    loadbalance_measured_int = 1;
+    pp.query("loadbalance_measured_int", loadbalance_measured_int);
+
+    loadbalance_measure_tagged_only = 0;
+    pp.query("loadbalance_measure_tagged_only", loadbalance_measure_tagged_only);
+
+    loadbalance_cost_smoothing = 0.5;
+    pp.query("loadbalance_cost_smoothing", loadbalance_cost_smoothing);
+    AMREX_ALWAYS_ASSERT(loadbalance_cost_smoothing > 0.0 && loadbalance_cost_smoothing <= 1.0);
+
+    loadbalance_efficiency_threshold = 0.9;
+    pp.query("loadbalance_efficiency_threshold", loadbalance_efficiency_threshold);
+
+    loadbalance_improvement_ratio = 1.1;
+    pp.query("loadbalance_improvement_ratio", loadbalance_improvement_ratio);
+
+    async_checkpoint_max_mem = 0;
+    pp.query("async_checkpoint_max_mem", async_checkpoint_max_mem);
+
+    checkpoint_delta = 0;
+    pp.query("checkpoint_delta", checkpoint_delta);
+
+    task_graph = 0;
+    pp.query("task_graph", task_graph);
+    task_graph_level = -1;
+    task_graph_dt_new = 0.0;
 }
 
 int
@@ -741,6 +778,8 @@ Amr::deleteDeriveSmallPlotVar (const std::string& name)
 
 Amr::~Amr ()
 {
+    finishAsyncCheckPoints(true);
+
     levelbld->variableCleanUp();
 
     Amr::Finalize();
@@ -1402,6 +1441,11 @@ Amr::restart (const std::string& filename)
         runlog << "RESTART from file = " << filename << '\n';
     }
 
+    delta_checkpoint_base = filename;
+    while (delta_checkpoint_base.size() > 1 && delta_checkpoint_base.back() == '/') {
+        delta_checkpoint_base.pop_back();
+    }
+
     // ---- preread and broadcast all FabArray headers if this file exists
     std::map<std::string, Vector<char> > faHeaderMap;
     if(prereadFAHeaders) {
@@ -1718,11 +1762,48 @@ Amr::checkPoint ()
         runlog << "CHECKPOINT: file = " << ckfile << '\n';
     }
 
+    if (AsyncOut::UseAsyncOut())
+    {
+        //
+        // Wait for earlier checkpoints still being written if the staging
+        // copies of this one would exceed the memory budget.
+        //
+        bool over_budget = false;
+        if (async_checkpoint_max_mem > 0)
+        {
+            auto staging_bytes = [] (const MultiFab& mf) -> Long {
+                Long r = 0;
+                for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                    r += mf[mfi].nBytes();
+                }
+                return r;
+            };
+            Long nbytes = 0;
+            for (int i = 0; i <= finest_level; ++i)
+            {
+                for (int k = 0; k < AmrLevel::get_desc_lst().size(); ++k)
+                {
+                    const StateData& sd = amr_level[i]->get_state_data(k);
+                    if (sd.descriptor()->store_in_checkpoint()) {
+                        nbytes += staging_bytes(sd.newData());
+                        if (sd.hasOldData()) {
+                            nbytes += staging_bytes(sd.oldData());
+                        }
+                    }
+                }
+            }
+            over_budget = AsyncOut::StagedBytes() + nbytes > async_checkpoint_max_mem;
+        }
+        ParallelDescriptor::ReduceBoolOr(over_budget);
+        finishAsyncCheckPoints(over_budget);
+    }
+
   amrex::StreamRetry sretry(ckfile, abort_on_stream_retry_failure,
                              stream_max_tries);
 
-  // For AsyncOut, we need to turn off stream retry and write to ckfile directly.
-  const std::string ckfileTemp = (AsyncOut::UseAsyncOut()) ? ckfile : (ckfile + ".temp");
+  // For AsyncOut, stream retry is turned off.  The data are written to
+  // ckfileTemp in the background, and finishAsyncCheckPoints renames it.
+  const std::string ckfileTemp = ckfile + ".temp";
 
   while(sretry.TryFileOutput()) {
 
@@ -1801,10 +1882,20 @@ Amr::checkPoint ()
         amr_level[i]->checkPointPre(ckfileTemp, HeaderFile);
     }
 
+    //
+    // Delta checkpoints are only written synchronously, and never over
+    // the checkpoint they would refer to.
+    //
+    const bool write_delta = checkpoint_delta && ! AsyncOut::UseAsyncOut();
+    StateData::SetDeltaCheckPoint(write_delta, delta_checkpoint_base == ckfile
+                                               ? std::string() : delta_checkpoint_base);
+
     for (int i = 0; i <= finest_level; ++i) {
         amr_level[i]->checkPoint(ckfileTemp, HeaderFile);
     }
 
+    StateData::SetDeltaCheckPoint(false);
+
     for (int i = 0; i <= finest_level; ++i) {
         amr_level[i]->checkPointPost(ckfileTemp, HeaderFile);
     }
@@ -1847,6 +1938,11 @@ Amr::checkPoint ()
     }
 
     if (AsyncOut::UseAsyncOut()) {
+        // The jobs of a process run in order, so this one runs after
+        // all the writes of this checkpoint.
+        auto done = std::make_shared<std::atomic<bool> >(false);
+        AsyncOut::Submit([=] () { done->store(true); });
+        pending_checkpoints.push_back(PendingCheckPoint{ckfileTemp, ckfile, done});
         break;
     } else {
         ParallelDescriptor::Barrier("Amr::checkPoint::end");
@@ -1854,6 +1950,7 @@ Amr::checkPoint ()
             std::rename(ckfileTemp.c_str(), ckfile.c_str());
         }
         ParallelDescriptor::Barrier("Renaming temporary checkPoint file.");
+        delta_checkpoint_base = ckfile;
     }
   }  // end while
 
@@ -1867,6 +1964,50 @@ Amr::checkPoint ()
   BL_PROFILE_REGION_STOP("Amr::checkPoint()");
 }
 
+void
+Amr::finishAsyncCheckPoints (bool wait)
+{
+    if (pending_checkpoints.empty()) {
+        return;
+    }
+
+    BL_PROFILE("Amr::finishAsyncCheckPoints()");
+
+    if (wait) {
+        AsyncOut::Finish();
+    }
+
+    //
+    // A checkpoint is complete once the jobs of all processes are done.
+    // Since the jobs run in order, the complete ones come first.
+    //
+    int ndone = 0;
+    for (auto const& ckp : pending_checkpoints) {
+        if (ckp.done->load()) {
+            ++ndone;
+        } else {
+            break;
+        }
+    }
+    ParallelDescriptor::ReduceIntMin(ndone);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        for (int i = 0; i < ndone; ++i)
+        {
+            const PendingCheckPoint& ckp = pending_checkpoints[i];
+            if (std::rename(ckp.temp_name.c_str(), ckp.name.c_str()) != 0) {
+                amrex::Warning("Amr::finishAsyncCheckPoints: failed to rename " + ckp.temp_name);
+            }
+            if (verbose > 0) {
+                amrex::Print() << "CHECKPOINT: " << ckp.name << " complete\n";
+            }
+        }
+    }
+
+    pending_checkpoints.erase(pending_checkpoints.begin(), pending_checkpoints.begin()+ndone);
+}
+
 void
 Amr::RegridOnly (Real time, bool do_io)
 {
@@ -1899,6 +2040,108 @@ Amr::RegridOnly (Real time, bool do_io)
     }
 }
 
+bool
+Amr::okToAdvanceWithNextLevel (int level)
+{
+    if (!task_graph || level >= finest_level || loadbalance_with_measured_cost) {
+        return false;
+    }
+
+    if (!amr_level[level]->supportsBoxAdvance() || !amr_level[level+1]->supportsBoxAdvance()) {
+        return false;
+    }
+
+    //
+    // The first substep of level+1 is advanced before its timeStep starts,
+    // so no regrid may be due there.
+    //
+    const int lev_top = std::min(finest_level, max_level-1);
+    for (int i = level+1; i <= lev_top; ++i)
+    {
+        if (okToRegrid(i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Real
+Amr::advanceWithNextLevel (int   level,
+                           Real  time,
+                           int   iteration,
+                           int   niter,
+                           Real& dt_new_fine)
+{
+    BL_PROFILE("Amr::advanceWithNextLevel()");
+
+    const int lev_fine = level+1;
+    AmrLevel& crse = *amr_level[level];
+    AmrLevel& fine = *amr_level[lev_fine];
+    const Real dt_crse = dt_level[level];
+    const Real dt_fine = dt_level[lev_fine];
+    const int ncycle = sub_cycle ? n_cycle[lev_fine] : 1;
+
+    if (verbose > 0)
+    {
+        amrex::Print() << "[Level " << lev_fine << " step " << level_steps[lev_fine]+1 << "] "
+                       << "ADVANCE with dt = " << dt_fine << " (together with level "
+                       << level << ")\n";
+    }
+
+    fine.setPostStepRegrid(0);
+    crse.advanceBegin(time, dt_crse, iteration, niter);
+    fine.advanceBegin(time, dt_fine, 1, ncycle);
+
+    const int cidx = crse.boxAdvanceStateType();
+    const int fidx = fine.boxAdvanceStateType();
+    const int ncc = AmrLevel::get_desc_lst()[cidx].nComp();
+    const int ncf = AmrLevel::get_desc_lst()[fidx].nComp();
+    const int ngc = crse.boxAdvanceNGrow();
+    const int ngf = fine.boxAdvanceNGrow();
+
+    MultiFab Sc(amrex::convert(crse.boxArray(), AmrLevel::get_desc_lst()[cidx].getType()),
+                crse.DistributionMap(), ncc, ngc, MFInfo(), crse.Factory());
+    MultiFab Sf(amrex::convert(fine.boxArray(), AmrLevel::get_desc_lst()[fidx].getType()),
+                fine.DistributionMap(), ncf, ngf, MFInfo(), fine.Factory());
+
+    //
+    // The first fine substep starts at the old coarse time, so its ghost
+    // cells only need coarse data at that time.  Hence both levels are
+    // filled before any box is advanced, and all their boxes are advanced
+    // together.  The later fine substeps need the new coarse data; they are
+    // advanced the usual way once this level is done.
+    //
+    AmrLevel::FillPatch(crse, Sc, ngc, time, cidx, 0, ncc);
+    AmrLevel::FillPatch(fine, Sf, ngf, time, fidx, 0, ncf);
+
+    const Vector<int>& crse_boxes = Sc.IndexArray();
+    const Vector<int>& fine_boxes = Sf.IndexArray();
+    const int ncrse = crse_boxes.size();
+    const int ntasks = ncrse + fine_boxes.size();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (Gpu::notInLaunchRegion())
+#endif
+    for (int i = 0; i < ntasks; ++i)
+    {
+        if (i < ncrse) {
+            crse.advanceBox(Sc, crse_boxes[i], time, dt_crse, iteration, niter);
+        } else {
+            fine.advanceBox(Sf, fine_boxes[i-ncrse], time, dt_fine, 1, ncycle);
+        }
+    }
+
+    //
+    // If the coarse level asks for a post-step regrid, timeStep does it when
+    // this returns, i.e., after the first fine substep.  The new fine level
+    // then starts from the fine data at the end of that substep.
+    //
+    const Real dt_new = crse.advanceEnd(time, dt_crse, iteration, niter);
+    dt_new_fine = fine.advanceEnd(time, dt_fine, 1, ncycle);
+
+    return dt_new;
+}
+
 void
 Amr::timeStep (int  level,
                Real time,
@@ -1913,14 +2156,26 @@ Amr::timeStep (int  level,
     //      when regridding is called with possible lbase > level.
     which_level_being_advanced = level;
 
+    //
+    // The first substep of this level may have been advanced together
+    // with the coarser level already (see advanceWithNextLevel).
+    //
+    const bool advanced_with_coarser = (level == task_graph_level);
+    task_graph_level = -1;
 
     // Update so that by default, we don't force a post-step regrid.
-    amr_level[level]->setPostStepRegrid(0);
+    if (!advanced_with_coarser) {
+        amr_level[level]->setPostStepRegrid(0);
+    }
 
+    if (advanced_with_coarser)
+    {
+        // okToAdvanceWithNextLevel has made sure that no regrid is due.
+    }
     //
     // Allow regridding of level 0 calculation on restart.
     //
-    if (max_level == 0 && regrid_on_restart)
+    else if (max_level == 0 && regrid_on_restart)
     {
         regrid_level_0_on_restart();
     }
@@ -1979,6 +2234,16 @@ Amr::timeStep (int  level,
                 level_count[0] = 0;
             }
         }
+
+        //
+        // All levels are synchronized at the beginning of a coarse step,
+        // so this is the only place where any of them can be rebalanced
+        // without losing data (e.g., in flux registers).
+        //
+        if (level == 0 && loadbalance_with_measured_cost)
+        {
+            LoadBalanceWithMeasuredCost(time);
+        }
     }
     //
     // Check to see if should write plotfile.
@@ -1992,15 +2257,42 @@ Amr::timeStep (int  level,
     //
     // Advance grids at this level.
     //
-    if (verbose > 0)
+    if (verbose > 0 && !advanced_with_coarser)
     {
         amrex::Print() << "[Level " << level << " step " << level_steps[level]+1 << "] "
                        << "ADVANCE with dt = " << dt_level[level] << "\n";
     }
 
-    Real dt_new = amr_level[level]->advance(time,dt_level[level],iteration,niter);
+    LayoutData<Real>* prev_cost_target = nullptr;
+    if (loadbalance_with_measured_cost)
+    {
+        auto& cost = measured_step_cost[level];
+        if (cost == nullptr || cost->boxArray() != boxArray(level)
+                            || cost->DistributionMap() != DistributionMap(level))
+        {
+            cost.reset(new LayoutData<Real>(boxArray(level), DistributionMap(level)));
+            for (MFIter mfi(*cost); mfi.isValid(); ++mfi) {
+                (*cost)[mfi] = 0.0;
+            }
+        }
+        prev_cost_target = MFIter::setCostTarget(cost.get(), loadbalance_measure_tagged_only);
+    }
+
+    Real dt_new;
+    if (advanced_with_coarser) {
+        dt_new = task_graph_dt_new;
+    } else if (okToAdvanceWithNextLevel(level)) {
+        dt_new = advanceWithNextLevel(level, time, iteration, niter, task_graph_dt_new);
+        task_graph_level = level+1;
+    } else {
+        dt_new = amr_level[level]->advance(time,dt_level[level],iteration,niter);
+    }
     BL_PROFILE_REGION_STOP("amr_level.advance");
 
+    if (loadbalance_with_measured_cost) {
+        MFIter::setCostTarget(prev_cost_target, loadbalance_measure_tagged_only);
+    }
+
     dt_min[level] = iteration == 1 ? dt_new : std::min(dt_min[level],dt_new);
 
     level_steps[level]++;
@@ -2284,6 +2576,8 @@ Amr::coarseTimeStep (Real stop_time)
         to_small_plot = 1;
     }
 
+    finishAsyncCheckPoints(false);
+
     if ((check_int > 0 && level_steps[0] % check_int == 0) || check_test == 1
         || to_checkpoint)
     {
@@ -2603,7 +2897,11 @@ Amr::regrid (int  lbase,
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
         else if (new_dmap[lev].empty()) {
-            new_dmap[lev].define(new_grid_places[lev]);
+            if (amr_level[lev] && !initial) {
+                new_dmap[lev] = MakeRegridDistributionMap(lev, new_grid_places[lev]);
+            } else {
+                new_dmap[lev].define(new_grid_places[lev]);
+            }
         }
 
         AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),new_grid_places[lev],
@@ -2628,6 +2926,7 @@ Amr::regrid (int  lbase,
             // NOTE: The init function may use a filPatch from the old level,
             //       which therefore needs remain in the hierarchy during the call.
             //
+            amr_level[lev]->m_movable_state = regrid_move_unchanged;
             a->init(*amr_level[lev]);
             amr_level[lev].reset(a);
             this->SetBoxArray(lev, amr_level[lev]->boxArray());
@@ -2754,12 +3053,115 @@ Amr::LoadBalanceLevel0 (Real time)
     amr_level[0]->post_regrid(0,0);
 }
 
+const LayoutData<Real>*
+Amr::measuredCost (int lev) const noexcept
+{
+    const auto& cost = measured_cost[lev];
+    if (cost && cost->boxArray() == boxArray(lev) && cost->DistributionMap() == DistributionMap(lev)) {
+        return cost.get();
+    } else {
+        return nullptr;
+    }
+}
+
+void
+Amr::LoadBalanceWithMeasuredCost (Real time)
+{
+    BL_PROFILE("LoadBalanceWithMeasuredCost()");
+
+    bool rebalanced = false;
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        auto& step_cost = measured_step_cost[lev];
+        if (step_cost == nullptr || step_cost->boxArray() != boxArray(lev)
+                                 || step_cost->DistributionMap() != DistributionMap(lev))
+        {
+            // The grids have changed since the measurement.
+            step_cost.reset();
+            measured_cost[lev].reset();
+            continue;
+        }
+
+        auto& cost = measured_cost[lev];
+        if (cost == nullptr || cost->boxArray() != step_cost->boxArray()
+                            || cost->DistributionMap() != step_cost->DistributionMap())
+        {
+            cost = std::move(step_cost);
+        }
+        else
+        {
+            const Real w = loadbalance_cost_smoothing;
+            for (MFIter mfi(*cost); mfi.isValid(); ++mfi) {
+                (*cost)[mfi] = w*(*step_cost)[mfi] + (1.0-w)*(*cost)[mfi];
+            }
+            step_cost.reset();
+        }
+
+        if (level_steps[0] % loadbalance_measured_int != 0 ||
+            ParallelDescriptor::NProcs() == 1) {
+            continue;
+        }
+
+        // Cheap check of the current efficiency before running the knapsack.
+        Real rank_cost = 0.0;
+        for (MFIter mfi(*cost); mfi.isValid(); ++mfi) {
+            rank_cost += (*cost)[mfi];
+        }
+        Real max_cost = rank_cost;
+        Real sum_cost = rank_cost;
+        ParallelDescriptor::ReduceRealMax(max_cost);
+        ParallelDescriptor::ReduceRealSum(sum_cost);
+        if (max_cost <= 0.0) continue;
+        const Real efficiency = sum_cost / (ParallelDescriptor::NProcs()*max_cost);
+        if (efficiency >= loadbalance_efficiency_threshold) continue;
+
+        const int nboxes = boxArray(lev).size();
+        Real navg = static_cast<Real>(nboxes) / static_cast<Real>(ParallelDescriptor::NProcs());
+        int nmax = static_cast<int>(std::max(std::round(loadbalance_max_fac*navg), std::ceil(navg)));
+
+        Real current_efficiency = 0.0, proposed_efficiency = 0.0;
+        const int root = ParallelDescriptor::IOProcessorNumber();
+        DistributionMapping newdm = DistributionMapping::makeKnapSack(*cost, current_efficiency,
+                                                                      proposed_efficiency, nmax,
+                                                                      true, root);
+        ParallelDescriptor::Bcast(&proposed_efficiency, 1, root);
+
+        if (verbose) {
+            amrex::Print() << "Measured-cost load balance on level " << lev << " at t = " << time
+                           << ": efficiency " << efficiency << " -> " << proposed_efficiency << "\n";
+        }
+
+        if (proposed_efficiency > loadbalance_improvement_ratio*efficiency)
+        {
+            InstallNewDistributionMap(lev, newdm);
+            // The measured cost moves with the boxes.
+            std::unique_ptr<LayoutData<Real> > newcost(new LayoutData<Real>(boxArray(lev), DistributionMap(lev)));
+            Vector<Real> allcost(nboxes);
+            ParallelDescriptor::GatherLayoutDataToVector<Real>(*cost, allcost, root);
+            ParallelDescriptor::Bcast(allcost.data(), nboxes, root);
+            for (MFIter mfi(*newcost); mfi.isValid(); ++mfi) {
+                (*newcost)[mfi] = allcost[mfi.index()];
+            }
+            cost = std::move(newcost);
+            rebalanced = true;
+        }
+    }
+
+    if (rebalanced) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            amr_level[lev]->post_regrid(0,finest_level);
+        }
+    }
+}
+
 void
 Amr::InstallNewDistributionMap (int lev, const DistributionMapping& newdm)
 {
     BL_PROFILE("InstallNewDistributionMap()");
 
     AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),boxArray(lev),newdm,cumtime);
+    amr_level[lev]->m_movable_state = regrid_move_unchanged;
     a->init(*amr_level[lev]);
     amr_level[lev].reset(a);
 
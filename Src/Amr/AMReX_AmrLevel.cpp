@@ -45,6 +45,35 @@ AmrLevel::postCoarseTimeStep (Real time)
     }
 }
 
+Real
+AmrLevel::advanceByBoxes (Real time,
+                          Real dt,
+                          int  iteration,
+                          int  ncycle)
+{
+    BL_PROFILE("AmrLevel::advanceByBoxes()");
+
+    advanceBegin(time, dt, iteration, ncycle);
+
+    const int index = boxAdvanceStateType();
+    const int ncomp = desc_lst[index].nComp();
+    const int ng = boxAdvanceNGrow();
+    MultiFab S(amrex::convert(grids,desc_lst[index].getType()), dmap, ncomp, ng,
+               MFInfo(), *m_factory);
+    FillPatch(*this, S, ng, time, index, 0, ncomp);
+
+    const Vector<int>& gridno = S.IndexArray();
+    const int nboxes = gridno.size();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (Gpu::notInLaunchRegion())
+#endif
+    for (int i = 0; i < nboxes; ++i) {
+        advanceBox(S, gridno[i], time, dt, iteration, ncycle);
+    }
+
+    return advanceEnd(time, dt, iteration, ncycle);
+}
+
 void
 AmrLevel::set_preferred_boundary_values (MultiFab& /*S*/,
                                          int       /*state_index*/,
@@ -987,6 +1016,8 @@ FillPatchIterator::Initialize (int  boxGrow,
     BL_ASSERT(scomp >= 0);
     BL_ASSERT(ncomp >= 1);
     BL_ASSERT(0 <= idx && idx < AmrLevel::desc_lst.size());
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_amrlevel.m_state_moved.empty() || !m_amrlevel.m_state_moved[idx],
+                                     "FillPatchIterator: state data have been moved out of this level by regrid");
 
     const StateDescriptor& desc = AmrLevel::desc_lst[idx];
 
@@ -2210,11 +2241,252 @@ AmrLevel::FillPatch (AmrLevel& amrlevel,
 {
     BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
     BL_ASSERT(boxGrow <= leveldata.nGrow());
+
+    if (amrlevel.m_movable_state && boxGrow == 0 && scomp == 0 && dcomp == 0
+        && ncomp == leveldata.nComp()
+        && FillPatchMovingUnchanged(amrlevel, leveldata, time, index))
+    {
+        return;
+    }
+
     FillPatchIterator fpi(amrlevel, leveldata, boxGrow, time, index, scomp, ncomp);
     const MultiFab& mf_fillpatched = fpi.get_mf();
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+void
+AmrLevel::FillPatch (AmrLevel&                amrlevel,
+                     const Vector<MultiFab*>& leveldata,
+                     const Vector<int>&       boxGrow,
+                     Real                     time,
+                     const Vector<int>&       index,
+                     const Vector<int>&       scomp,
+                     const Vector<int>&       ncomp)
+{
+    BL_PROFILE("AmrLevel::FillPatch(Vector)");
+
+    const int nstates = leveldata.size();
+    BL_ASSERT(boxGrow.size() == nstates && index.size() == nstates &&
+              scomp.size() == nstates && ncomp.size() == nstates);
+
+    const int level = amrlevel.level;
+    const Geometry& geom = amrlevel.geom;
+    AmrLevel* crse_level = (level > 0) ? &(amrlevel.parent->getLevel(level-1)) : nullptr;
+
+    // One entry per range of components with the same interpolater.
+    Vector<MultiFab*> mf;
+    Vector<IntVect> nghost;
+    Vector<Vector<MultiFab*> > smf_crse, smf_fine;
+    Vector<Vector<Real> > stime_crse, stime_fine;
+    Vector<int> sc, dc, nc;
+    Vector<std::unique_ptr<StateDataPhysBCFunct> > physbcf_crse, physbcf_fine;
+    Vector<StateDataPhysBCFunct*> pbc_crse, pbc_fine;
+    Vector<Interpolater*> mapper;
+    Vector<Vector<BCRec> > bcs;
+
+    Vector<std::unique_ptr<MultiFab> > fabs(nstates);
+
+    for (int i = 0; i < nstates; ++i)
+    {
+        BL_ASSERT(ncomp[i] <= leveldata[i]->nComp());
+        BL_ASSERT(boxGrow[i] <= leveldata[i]->nGrow());
+        BL_ASSERT(0 <= index[i] && index[i] < desc_lst.size());
+
+        if (amrlevel.m_movable_state && boxGrow[i] == 0 && scomp[i] == 0
+            && ncomp[i] == leveldata[i]->nComp()
+            && FillPatchMovingUnchanged(amrlevel, *leveldata[i], time, index[i]))
+        {
+            continue;
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(amrlevel.m_state_moved.empty() || !amrlevel.m_state_moved[index[i]],
+                                         "AmrLevel::FillPatch: state data have been moved out of this level by regrid");
+
+        const StateDescriptor& desc = desc_lst[index[i]];
+        const auto& range = desc.sameInterps(scomp[i], ncomp[i]);
+
+        bool nested = true;
+        if (level > 1) {
+            for (auto const& r : range) {
+                nested = nested && amrex::ProperlyNested(amrlevel.crse_ratio,
+                                                         amrlevel.parent->blockingFactor(level),
+                                                         boxGrow[i], leveldata[i]->ixType(),
+                                                         desc.interp(r.first));
+            }
+        }
+
+        if (!nested)
+        {
+            // Two coarse levels may be needed.  Use FillPatchIterator for this state type.
+            FillPatchIterator fpi(amrlevel, *leveldata[i], boxGrow[i], time, index[i], scomp[i], ncomp[i]);
+            MultiFab::Copy(*leveldata[i], fpi.get_mf(), 0, 0, ncomp[i], boxGrow[i]);
+            continue;
+        }
+
+        fabs[i] = std::make_unique<MultiFab>(leveldata[i]->boxArray(), leveldata[i]->DistributionMap(),
+                                             ncomp[i], boxGrow[i], MFInfo(), leveldata[i]->Factory());
+        fabs[i]->setDomainBndry(std::numeric_limits<Real>::quiet_NaN(), geom);
+
+        StateData& statedata_fine = amrlevel.state[index[i]];
+        Vector<MultiFab*> smf;
+        Vector<Real> stime;
+        statedata_fine.getData(smf,stime,time);
+
+        Vector<MultiFab*> smfc;
+        Vector<Real> stimec;
+        if (crse_level) {
+            crse_level->state[index[i]].getData(smfc,stimec,time);
+        }
+
+        for (int j = 0, DComp = 0; j < static_cast<int>(range.size()); ++j)
+        {
+            const int SComp = range[j].first;
+            const int NComp = range[j].second;
+
+            mf.push_back(fabs[i].get());
+            nghost.push_back(IntVect(boxGrow[i]));
+            sc.push_back(SComp);
+            dc.push_back(DComp);
+            nc.push_back(NComp);
+            smf_fine.push_back(smf);
+            stime_fine.push_back(stime);
+            physbcf_fine.push_back(std::make_unique<StateDataPhysBCFunct>(statedata_fine,SComp,geom));
+            pbc_fine.push_back(physbcf_fine.back().get());
+
+            if (crse_level) {
+                smf_crse.push_back(smfc);
+                stime_crse.push_back(stimec);
+                physbcf_crse.push_back(std::make_unique<StateDataPhysBCFunct>
+                                       (crse_level->state[index[i]],SComp,crse_level->geom));
+                pbc_crse.push_back(physbcf_crse.back().get());
+                mapper.push_back(desc.interp(SComp));
+                bcs.push_back(desc.getBCs());
+            }
+
+            DComp += NComp;
+        }
+    }
+
+    if (!mf.empty())
+    {
+        if (level == 0)
+        {
+            amrex::FillPatchSingleLevel(mf, nghost, time, smf_fine, stime_fine, sc, dc, nc,
+                                        geom, pbc_fine, sc);
+        }
+        else
+        {
+            amrex::FillPatchTwoLevels(mf, nghost, time,
+                                      smf_crse, stime_crse,
+                                      smf_fine, stime_fine,
+                                      sc, dc, nc,
+                                      crse_level->geom, geom,
+                                      pbc_crse, sc,
+                                      pbc_fine, sc,
+                                      crse_level->fineRatio(),
+                                      mapper, bcs, sc);
+        }
+    }
+
+    for (int i = 0; i < nstates; ++i)
+    {
+        if (fabs[i])
+        {
+            amrlevel.set_preferred_boundary_values(*fabs[i], index[i], scomp[i], 0, ncomp[i], time);
+            MultiFab::Copy(*leveldata[i], *fabs[i], 0, 0, ncomp[i], boxGrow[i]);
+        }
+    }
+}
+
+bool
+AmrLevel::FillPatchMovingUnchanged (AmrLevel& old,
+                                    MultiFab& leveldata,
+                                    Real      time,
+                                    int       index)
+{
+    BL_PROFILE("AmrLevel::FillPatchMovingUnchanged()");
+
+    StateData& sd = old.state[index];
+
+    Vector<MultiFab*> smf;
+    Vector<Real> stime;
+    sd.getData(smf, stime, time);
+    if (smf.size() != 1 || smf[0] != &sd.newData()) return false;
+
+    MultiFab& src = sd.newData();
+    if (src.nComp() != leveldata.nComp() || src.nGrowVect() != leveldata.nGrowVect()
+        || src.ixType() != leveldata.ixType() || src.arena() != leveldata.arena()
+        || leveldata.hasEBFabFactory()) {
+        return false;
+    }
+
+    // Aliased FABs cannot be moved.
+    bool owner = true;
+    for (MFIter mfi(leveldata); mfi.isValid(); ++mfi) {
+        owner = owner && (leveldata[mfi].nBytesOwned() == leveldata[mfi].nBytes());
+    }
+    ParallelDescriptor::ReduceBoolAnd(owner);
+    if (!owner) return false;
+
+    const BoxArray& ba = leveldata.boxArray();
+    const DistributionMapping& dm = leveldata.DistributionMap();
+    const BoxArray& sba = src.boxArray();
+    const DistributionMapping& sdm = src.DistributionMap();
+
+    Vector<int> src_index(ba.size(), -1);
+    BoxList changed_bl(ba.ixType());
+    Vector<int> changed_pmap;
+    Vector<int> changed_index;
+    std::vector< std::pair<int,Box> > isects;
+    for (int i = 0, N = ba.size(); i < N; ++i)
+    {
+        const Box& bx = ba[i];
+        sba.intersections(bx, isects);
+        for (auto const& is : isects) {
+            if (sba[is.first] == bx && sdm[is.first] == dm[i]) {
+                src_index[i] = is.first;
+                break;
+            }
+        }
+        if (src_index[i] < 0) {
+            changed_bl.push_back(bx);
+            changed_pmap.push_back(dm[i]);
+            changed_index.push_back(i);
+        }
+    }
+
+    if (changed_index.size() == ba.size()) return false;
+
+    if (!changed_index.empty())
+    {
+        // Fill the changed boxes through aliases, before the unchanged
+        // FABs are moved out of the source.
+        MultiFab tmp(BoxArray(std::move(changed_bl)), DistributionMapping(std::move(changed_pmap)),
+                     leveldata.nComp(), leveldata.nGrowVect(), MFInfo().SetAlloc(false));
+        for (MFIter mfi(tmp); mfi.isValid(); ++mfi) {
+            tmp.setFab(mfi, new FArrayBox(leveldata[changed_index[mfi.index()]], amrex::make_alias,
+                                          0, leveldata.nComp()));
+        }
+        FillPatchIterator fpi(old, tmp, 0, time, index, 0, tmp.nComp());
+        MultiFab::Copy(tmp, fpi.get_mf(), 0, 0, tmp.nComp(), 0);
+    }
+
+    for (MFIter mfi(leveldata); mfi.isValid(); ++mfi)
+    {
+        const int j = src_index[mfi.index()];
+        if (j >= 0) {
+            leveldata.swapFab(mfi.index(), src, j);
+        }
+    }
+
+    if (old.m_state_moved.empty()) {
+        old.m_state_moved.resize(old.state.size(), 0);
+    }
+    old.m_state_moved[index] = 1;
+
+    return true;
+}
+
 void
 AmrLevel::FillPatchAdd (AmrLevel& amrlevel,
                         MultiFab& leveldata,
@@ -26,6 +26,8 @@ static constexpr int MFOLDDATA = 1;
 
 Vector<std::string> StateData::fabArrayHeaderNames;
 std::map<std::string, Vector<char> > *StateData::faHeaderMap;
+bool StateData::deltaCheckPoint = false;
+std::string StateData::deltaCheckPointBase;
 
 
 StateData::StateData ()
@@ -825,6 +827,10 @@ StateData::checkPoint (const std::string& name,
         std::string mf_fullpath_new(fullpathname + NewSuffix);
         if (AsyncOut::UseAsyncOut()) {
             VisMF::AsyncWrite(*new_data,mf_fullpath_new);
+        } else if (deltaCheckPoint) {
+            VisMF::WriteDelta(*new_data,mf_fullpath_new,
+                              deltaCheckPointBase.empty() ? std::string()
+                                  : deltaCheckPointBase + "/" + name + NewSuffix, how);
         } else {
             VisMF::Write(*new_data,mf_fullpath_new,how);
         }
@@ -835,6 +841,10 @@ StateData::checkPoint (const std::string& name,
             std::string mf_fullpath_old(fullpathname + OldSuffix);
             if (AsyncOut::UseAsyncOut()) {
                 VisMF::AsyncWrite(*old_data,mf_fullpath_old);
+            } else if (deltaCheckPoint) {
+                VisMF::WriteDelta(*old_data,mf_fullpath_old,
+                                  deltaCheckPointBase.empty() ? std::string()
+                                      : deltaCheckPointBase + "/" + name + OldSuffix, how);
             } else {
                 VisMF::Write(*old_data,mf_fullpath_old,how);
             }
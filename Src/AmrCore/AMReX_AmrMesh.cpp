@@ -354,6 +354,9 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
         pp.query("refine_grid_layout", refine_grid_layout);
     }
 
+    pp.query("regrid_keep_prior_boxes", regrid_keep_prior_boxes);
+    pp.query("regrid_keep_owners", regrid_keep_owners);
+
     pp.query("check_input", check_input);
 
     finest_level = -1;
@@ -772,16 +775,72 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                 amrex::Abort("AmrMesh::MakeNewGrids: how did this happen?");
             }
         }
-        else if (refine_grid_layout)
+        else
         {
-            ChopGrids(lev,new_grids[lev],ParallelDescriptor::NProcs());
-            if (new_grids[lev] == grids[lev]) {
+            if (refine_grid_layout)
+            {
+                ChopGrids(lev,new_grids[lev],ParallelDescriptor::NProcs());
+            }
+            if (regrid_keep_prior_boxes && lev <= finest_level)
+            {
+                KeepPriorBoxes(lev,new_grids[lev]);
+            }
+            if (lev <= finest_level && new_grids[lev] == grids[lev]) {
                 new_grids[lev] = grids[lev]; // to avoid dupliates
             }
         }
     }
 }
 
+void
+AmrMesh::KeepPriorBoxes (int lev, BoxArray& new_ba) const
+{
+    BL_PROFILE("AmrMesh::KeepPriorBoxes()");
+
+    const BoxArray& old_ba = grids[lev];
+    if (old_ba.empty() || new_ba == old_ba) return;
+
+    // The new grids are disjoint, properly nested and aligned with the
+    // blocking factor, and so are the old grids.  Hence the old boxes
+    // covered by the new grids and the remainder satisfy all the grid
+    // constraints too.
+    BoxList kept(new_ba.ixType());
+    for (int i = 0, N = old_ba.size(); i < N; ++i) {
+        if (new_ba.contains(old_ba[i], true)) {
+            kept.push_back(old_ba[i]);
+        }
+    }
+    if (kept.isEmpty()) return;
+
+    const BoxArray kept_ba(kept);
+    BoxList rest(new_ba.ixType());
+    for (int i = 0, N = new_ba.size(); i < N; ++i) {
+        rest.join(kept_ba.complementIn(new_ba[i]));
+    }
+    rest.simplify();
+    rest.maxSize(max_grid_size[lev]);
+
+    // Do not let the grids fragment without bound.
+    if (kept.size() + rest.size() > 2*new_ba.size()) return;
+
+    kept.join(rest);
+    new_ba = BoxArray(std::move(kept));
+}
+
+DistributionMapping
+AmrMesh::MakeRegridDistributionMap (int lev, const BoxArray& ba) const
+{
+    if (regrid_keep_owners && lev < static_cast<int>(grids.size())
+        && !grids[lev].empty() && !dmap[lev].empty())
+    {
+        return DistributionMapping::makeKeepingOwners(ba, grids[lev], dmap[lev]);
+    }
+    else
+    {
+        return DistributionMapping(ba);
+    }
+}
+
 void
 AmrMesh::MakeNewGrids (Real time)
 {
@@ -37,11 +37,12 @@ FaceDivFree               face_divfree_interp;
 CellConservativeLinear    lincc_interp;
 CellConservativeLinear    cell_cons_interp(0);
 
+CellQuadratic             quadratic_interp;
+CellConservativeQuartic   quartic_interp;
+
 #ifndef BL_NO_FORT
 CellBilinear              cell_bilinear_interp;
-CellQuadratic             quadratic_interp;
 CellConservativeProtected protected_interp;
-CellConservativeQuartic   quartic_interp;
 #endif
 
 Interpolater::~Interpolater () {}
@@ -436,6 +437,13 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     const Box& crse_region = CoarseBox(fine_region,ratio);
     const Box& cslope_bx = amrex::grow(crse_region,-1);
 
+    if (!run_on_gpu) {
+        const Vector<Real>& vec_voff = amrex::ccinterp_compute_voff(cslope_bx, ratio, crse_geom, fine_geom);
+        amrex::cellconslin_interp_rows(fine_region, finearr, fine_comp, ncomp, crsearr, crse_comp,
+                                       bcr.data(), vec_voff.data(), ratio, do_linear_limiting);
+        return;
+    }
+
     AsyncArray<BCRec> async_bcr(bcr.data(), (run_on_gpu) ? ncomp : 0);
     BCRec const* bcrp = (run_on_gpu) ? async_bcr.data() : bcr.data();
 
@@ -500,7 +508,6 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     }
 }
 
-#ifndef BL_NO_FORT
 CellQuadratic::CellQuadratic (bool limit)
 {
     do_limited_slope = limit;
@@ -541,11 +548,12 @@ CellQuadratic::interp (const FArrayBox& crse,
                        int              actual_state,
                        RunOn            /*runon*/)
 {
-#if (AMREX_SPACEDIM == 1)
+#if (AMREX_SPACEDIM != 2)
     amrex::ignore_unused(crse,crse_comp,fine,fine_comp,ncomp,fine_region,
                          ratio,crse_geom,fine_geom,bcr,actual_comp,actual_state);
-    amrex::Abort("1D CellQuadratic::interp not supported");
+    amrex::Abort("CellQuadratic::interp only supported in 2D");
 #else
+    amrex::ignore_unused(actual_comp,actual_state);
     BL_PROFILE("CellQuadratic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
     //
@@ -554,83 +562,29 @@ CellQuadratic::interp (const FArrayBox& crse,
     Box target_fine_region = fine_region & fine.box();
 
     Box crse_bx(amrex::coarsen(target_fine_region,ratio));
-    Box fslope_bx(amrex::refine(crse_bx,ratio));
-    Box cslope_bx(crse_bx);
-    cslope_bx.grow(1);
-    BL_ASSERT(crse.box().contains(cslope_bx));
-    //
-    // Alloc temp space for coarse grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms
-    //
-    long t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int c_len = int(t_long);
-
-    Vector<Real> cslope(5*c_len);
-
-    int loslp = cslope_bx.index(crse_bx.smallEnd());
-    int hislp = cslope_bx.index(crse_bx.bigEnd());
-
-    t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int cslope_vol = int(t_long);
-    int clo        = 1 - loslp;
-    int chi        = clo + cslope_vol - 1;
-    c_len          = hislp - loslp + 1;
-    //
-    // Alloc temp space for one strip of fine grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms.
-    //
-    int dir;
-    int f_len = fslope_bx.longside(dir);
-
-    Vector<Real> strip((5+2)*f_len);
-
-    Real* fstrip = strip.dataPtr();
-    Real* foff   = fstrip + f_len;
-    Real* fslope = foff + f_len;
+    BL_ASSERT(crse.box().contains(amrex::grow(crse_bx,1)));
     //
     // Get coarse and fine edge-centered volume coordinates.
     //
     Vector<Real> fvc[AMREX_SPACEDIM];
     Vector<Real> cvc[AMREX_SPACEDIM];
-    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
     {
         fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
         crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
     }
-    //
-    // Alloc tmp space for slope calc and to allow for vectorization.
-    //
-    Real* fdat        = fine.dataPtr(fine_comp);
-    const Real* cdat  = crse.dataPtr(crse_comp);
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* fslo   = fslope_bx.loVect();
-    const int* fshi   = fslope_bx.hiVect();
-    int slope_flag    = (do_limited_slope ? 1 : 0);
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
 
-    amrex_cqinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                   AMREX_ARLIM(fblo), AMREX_ARLIM(fbhi),
-                   &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                   cdat,&clo,&chi,
-                   AMREX_ARLIM(cblo), AMREX_ARLIM(cbhi),
-                   fslo,fshi,
-                   cslope.dataPtr(),&c_len,fslope,fstrip,&f_len,foff,
-                   bc.dataPtr(), &slope_flag,
-                   AMREX_D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
-                   AMREX_D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
-                   &actual_comp,&actual_state);
+    Vector<Real> buf(5*crse_bx.length(0) + target_fine_region.length(0));
 
-#endif /*(AMREX_SPACEDIM > 1)*/
-}
+    amrex::cellquadratic_interp(target_fine_region, crse_bx,
+                                fine.array(), fine_comp, ncomp,
+                                crse.const_array(), crse_comp,
+                                bcr.data(), ratio,
+                                fvc[0].data(), fvc[1].data(),
+                                cvc[0].data(), cvc[1].data(),
+                                buf.data());
 #endif
+}
 
 
 PCInterp::~PCInterp () {}
@@ -863,7 +817,6 @@ CellConservativeProtected::protect (const FArrayBox& crse,
 }
 #endif
 
-#ifndef BL_NO_FORT
 CellConservativeQuartic::~CellConservativeQuartic () {}
 
 Box
@@ -895,19 +848,15 @@ CellConservativeQuartic::interp (const FArrayBox&  crse,
                                  const Geometry&   /* crse_geom */,
                                  const Geometry&   /* fine_geom */,
                                  Vector<BCRec> const&   bcr,
-                                 int               actual_comp,
-                                 int               actual_state,
+                                 int               /*actual_comp*/,
+                                 int               /*actual_state*/,
                                  RunOn             /*runon*/)
 {
     BL_PROFILE("CellConservativeQuartic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
-    BL_ASSERT(ratio[0]==2);
-#if (AMREX_SPACEDIM >= 2)
-    BL_ASSERT(ratio[0] == ratio[1]);
-#endif
-#if (AMREX_SPACEDIM == 3)
-    BL_ASSERT(ratio[1] == ratio[2]);
-#endif
+    amrex::ignore_unused(bcr);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ratio == 2,
+                                     "CellConservativeQuartic: only refinement ratio 2 is supported");
 
     //
     // Make box which is intersection of fine_region and domain of fine.
@@ -917,53 +866,34 @@ CellConservativeQuartic::interp (const FArrayBox&  crse,
     // crse_bx is coarsening of target_fine_region, grown by 2.
     //
     Box crse_bx = CoarseBox(target_fine_region,ratio);
+    BL_ASSERT(crse.box().contains(crse_bx));
 
-    Box crse_bx2(crse_bx);
-    crse_bx2.grow(-2);
-    Box fine_bx2 = amrex::refine(crse_bx2,ratio);
-
-    Real* fdat       = fine.dataPtr(fine_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* cb2lo  = crse_bx2.loVect();
-    const int* cb2hi  = crse_bx2.hiVect();
-    const int* fb2lo  = fine_bx2.loVect();
-    const int* fb2hi  = fine_bx2.hiVect();
-
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-
-    int ltmp = fb2hi[0]-fb2lo[0]+1;
-    Vector<Real> ftmp(ltmp);
+    Array4<Real> const& finearr = fine.array();
+    Array4<Real const> const& crsearr = crse.const_array();
 
-#if (AMREX_SPACEDIM >= 2)
-    ltmp = (cbhi[0]-cblo[0]+1)*ratio[1];
-    Vector<Real> ctmp(ltmp);
+#if (AMREX_SPACEDIM == 1)
+    amrex::ignore_unused(crse_bx);
+    amrex::cellconsquartic_interp(target_fine_region, finearr, fine_comp, ncomp,
+                                  crsearr, crse_comp);
+#else
+    const IntVect& clo = crse_bx.smallEnd();
+    const IntVect& chi = crse_bx.bigEnd();
+    const Box ctmp_bx(IntVect(AMREX_D_DECL(clo[0],0,0)), IntVect(AMREX_D_DECL(chi[0],1,0)));
+    Vector<Real> ctmp(ctmp_bx.numPts());
+#if (AMREX_SPACEDIM == 2)
+    amrex::cellconsquartic_interp(target_fine_region, finearr, fine_comp, ncomp,
+                                  crsearr, crse_comp,
+                                  makeArray4(ctmp.data(), ctmp_bx, 1));
+#else
+    const Box ctmp2_bx(IntVect(clo[0],clo[1],0), IntVect(chi[0],chi[1],1));
+    Vector<Real> ctmp2(ctmp2_bx.numPts());
+    amrex::cellconsquartic_interp(target_fine_region, finearr, fine_comp, ncomp,
+                                  crsearr, crse_comp,
+                                  makeArray4(ctmp.data(), ctmp_bx, 1),
+                                  makeArray4(ctmp2.data(), ctmp2_bx, 1));
 #endif
-
-#if (AMREX_SPACEDIM == 3)
-    ltmp = (cbhi[0]-cblo[0]+1)*(cbhi[1]-cblo[1]+1)*ratio[2];
-    Vector<Real> ctmp2(ltmp);
 #endif
-
-    amrex_quartinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                       fblo, fbhi, fb2lo, fb2hi,
-                       cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-                       cblo, cbhi, cb2lo, cb2hi,
-                       &ncomp,
-                       AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                       AMREX_D_DECL(ftmp.dataPtr(), ctmp.dataPtr(), ctmp2.dataPtr()),
-                       bc.dataPtr(),&actual_comp,&actual_state);
 }
-#endif
 
 FaceDivFree::~FaceDivFree () {}
 
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
 #include <cmath>
 #include <climits>
 
@@ -13,6 +15,157 @@
 
 namespace amrex {
 
+namespace {
+
+//
+// Bit masks of cells, with 64 cells of an x-row in each word.  These are
+// used on the host for buffering, coarsening and collating tags.
+//
+using TagWord = std::uint64_t;
+constexpr int TagWordBits = 64;
+
+int tag_ctz (TagWord w) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(w);
+#else
+    int n = 0;
+    while ((w & 1) == 0) { w >>= 1; ++n; }
+    return n;
+#endif
+}
+
+int tag_popcount (TagWord w) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    int n = 0;
+    for (; w != 0; w &= w-1) { ++n; }
+    return n;
+#endif
+}
+
+class TagBitMask
+{
+public:
+
+    explicit TagBitMask (Box const& bx)
+        : m_lo(amrex::lbound(bx)),
+          m_len(amrex::length(bx)),
+          m_nw((m_len.x+TagWordBits-1)/TagWordBits),
+          m_bits(static_cast<std::size_t>(m_nw)*m_len.y*m_len.z, 0)
+        {}
+
+    //! Set the bits of the cells with pred(a(i,j,k)) true.
+    template <class T, class P>
+    void set (Array4<T> const& a, P&& pred) noexcept
+    {
+        for (int k = m_lo.z; k < m_lo.z+m_len.z; ++k) {
+        for (int j = m_lo.y; j < m_lo.y+m_len.y; ++j) {
+            T const* p = a.ptr(m_lo.x,j,k);
+            TagWord* r = row(j,k);
+            for (int w = 0; w < m_nw; ++w) {
+                const int nb = std::min(TagWordBits, m_len.x - w*TagWordBits);
+                TagWord v = 0;
+                for (int b = 0; b < nb; ++b) {
+                    v |= static_cast<TagWord>(pred(p[w*TagWordBits+b])) << b;
+                }
+                r[w] = v;
+            }
+        }}
+    }
+
+    TagWord* row (int j, int k) noexcept {
+        return m_bits.data() + (static_cast<std::size_t>(k-m_lo.z)*m_len.y + (j-m_lo.y))*m_nw;
+    }
+
+    TagWord const* row (int j, int k) const noexcept {
+        return m_bits.data() + (static_cast<std::size_t>(k-m_lo.z)*m_len.y + (j-m_lo.y))*m_nw;
+    }
+
+    //! r |= the bits of row in shifted by s cells (towards higher i for s > 0).
+    void orShifted (TagWord* r, TagWord const* in, int s) const noexcept
+    {
+        const int t  = std::abs(s);
+        const int ws = t / TagWordBits;
+        const int bs = t % TagWordBits;
+        if (s >= 0) {
+            for (int w = m_nw-1; w >= ws; --w) {
+                TagWord v = in[w-ws] << bs;
+                if (bs > 0 && w-ws-1 >= 0) { v |= in[w-ws-1] >> (TagWordBits-bs); }
+                r[w] |= v;
+            }
+        } else {
+            for (int w = 0; w < m_nw-ws; ++w) {
+                TagWord v = in[w+ws] >> bs;
+                if (bs > 0 && w+ws+1 < m_nw) { v |= in[w+ws+1] << (TagWordBits-bs); }
+                r[w] |= v;
+            }
+        }
+        const int tail = m_len.x % TagWordBits;
+        if (tail > 0) { r[m_nw-1] &= (TagWord(1) << tail) - 1; }
+    }
+
+    //! Is any bit of row r in [i0,i1] set?
+    bool any (TagWord const* r, int i0, int i1) const noexcept
+    {
+        const int b0 = std::max(i0, m_lo.x) - m_lo.x;
+        const int b1 = std::min(i1, m_lo.x+m_len.x-1) - m_lo.x;
+        if (b0 > b1) { return false; }
+        const int w0 = b0 / TagWordBits;
+        const int w1 = b1 / TagWordBits;
+        for (int w = w0; w <= w1; ++w) {
+            TagWord m = ~TagWord(0);
+            if (w == w0) { m &= ~TagWord(0) << (b0 % TagWordBits); }
+            if (w == w1) { m &= ~TagWord(0) >> (TagWordBits-1 - b1 % TagWordBits); }
+            if (r[w] & m) { return true; }
+        }
+        return false;
+    }
+
+    bool empty () const noexcept
+    {
+        return std::all_of(m_bits.begin(), m_bits.end(), [] (TagWord w) { return w == 0; });
+    }
+
+    Long count () const noexcept
+    {
+        Long n = 0;
+        for (TagWord w : m_bits) { n += tag_popcount(w); }
+        return n;
+    }
+
+    //! Call f(i,j,k) for each set bit, in Box order.
+    template <class F>
+    void forEach (F&& f) const noexcept
+    {
+        for (int k = m_lo.z; k < m_lo.z+m_len.z; ++k) {
+        for (int j = m_lo.y; j < m_lo.y+m_len.y; ++j) {
+            TagWord const* r = row(j,k);
+            for (int w = 0; w < m_nw; ++w) {
+                for (TagWord v = r[w]; v != 0; v &= v-1) {
+                    f(m_lo.x + w*TagWordBits + tag_ctz(v), j, k);
+                }
+            }
+        }}
+    }
+
+    Dim3 const& lo () const noexcept { return m_lo; }
+    Dim3 const& len () const noexcept { return m_len; }
+    int nWords () const noexcept { return m_nw; }
+    Vector<TagWord> const& words () const noexcept { return m_bits; }
+    Vector<TagWord>& words () noexcept { return m_bits; }
+
+private:
+    Dim3 m_lo;
+    Dim3 m_len;
+    int m_nw;
+    Vector<TagWord> m_bits;
+};
+
+}
+
 TagBox::TagBox () noexcept {}
 
 TagBox::TagBox (Arena* ar) noexcept
@@ -45,6 +198,35 @@ TagBox::coarsen (const IntVect& ratio, const Box& cbox) noexcept
     Dim3 r{1,1,1};
     AMREX_D_TERM(r.x = ratio[0];, r.y = ratio[1];, r.z = ratio[2]);
 
+    if (Gpu::notInLaunchRegion())
+    {
+        // ---- OR the fine rows of each coarse row, then test the bits of each coarse cell
+        TagBitMask fmask(fdomain);
+        fmask.set(farr, [] (char t) { return t != TagBox::CLEAR; });
+        const auto flo = amrex::lbound(fdomain);
+        const auto fhi = amrex::ubound(fdomain);
+        const auto clo = amrex::lbound(cbox);
+        const auto chi = amrex::ubound(cbox);
+        Vector<TagWord> crow(fmask.nWords());
+        for (int k = clo.z; k <= chi.z; ++k) {
+        for (int j = clo.y; j <= chi.y; ++j) {
+            std::fill(crow.begin(), crow.end(), TagWord(0));
+            bool has_tags = false;
+            for (int kk = std::max(k*r.z,flo.z); kk <= std::min(k*r.z+r.z-1,fhi.z); ++kk) {
+            for (int jj = std::max(j*r.y,flo.y); jj <= std::min(j*r.y+r.y-1,fhi.y); ++jj) {
+                TagWord const* frow = fmask.row(jj,kk);
+                for (int w = 0; w < fmask.nWords(); ++w) {
+                    crow[w] |= frow[w];
+                    has_tags = has_tags || frow[w] != 0;
+                }
+            }}
+            for (int i = clo.x; i <= chi.x; ++i) {
+                carr(i,j,k) = has_tags && fmask.any(crow.data(), i*r.x, i*r.x+r.x-1);
+            }
+        }}
+    }
+    else
+    {
     AMREX_HOST_DEVICE_FOR_3D(cbox, i, j, k,
     {
         TagType t = TagBox::CLEAR;
@@ -62,6 +244,7 @@ TagBox::coarsen (const IntVect& ratio, const Box& cbox) noexcept
         }
         carr(i,j,k) = t;
     });
+    }
 
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
@@ -81,6 +264,49 @@ TagBox::buffer (const IntVect& a_nbuff) noexcept
     Dim3 nbuf = a_nbuff.dim3();
     const auto lo = amrex::lbound(domain);
     const auto hi = amrex::ubound(domain);
+
+    if (Gpu::notInLaunchRegion())
+    {
+        // ---- dilate the SET cells one direction at a time with word operations
+        TagBitMask mask(domain);
+        mask.set(a, [] (char t) { return t == TagBox::SET; });
+        if (mask.count() == 0) { return; }
+
+        TagBitMask dmask(domain);
+        for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            for (int s = -nbuf.x; s <= nbuf.x; ++s) {
+                dmask.orShifted(dmask.row(j,k), mask.row(j,k), s);
+            }
+        }}
+
+        const int nw = mask.nWords();
+        for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            TagWord* r = mask.row(j,k);
+            std::fill(r, r+nw, TagWord(0));
+            for (int jj = std::max(j-nbuf.y,lo.y); jj <= std::min(j+nbuf.y,hi.y); ++jj) {
+                TagWord const* d = dmask.row(jj,k);
+                for (int w = 0; w < nw; ++w) { r[w] |= d[w]; }
+            }
+        }}
+
+        for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            TagWord* r = dmask.row(j,k);
+            std::fill(r, r+nw, TagWord(0));
+            for (int kk = std::max(k-nbuf.z,lo.z); kk <= std::min(k+nbuf.z,hi.z); ++kk) {
+                TagWord const* m = mask.row(j,kk);
+                for (int w = 0; w < nw; ++w) { r[w] |= m[w]; }
+            }
+        }}
+
+        dmask.forEach([&] (int i, int j, int k) {
+            if (a(i,j,k) == TagBox::CLEAR) { a(i,j,k) = TagBox::BUF; }
+        });
+        return;
+    }
+
     AMREX_HOST_DEVICE_FOR_3D(domain, i, j, k,
     {
         if (a(i,j,k) == TagBox::CLEAR) {
@@ -345,12 +571,21 @@ TagBoxArray::mapPeriodicRemoveDuplicates (const Geometry& geom)
 #pragma omp parallel
 #endif
         for (MFIter mfi(tmp); mfi.isValid(); ++mfi) {
+            // ---- clear the tagged cells that are not owned, found with word operations
             Box const& box = mfi.fabbox();
             Array4<TagType> const& tag = tmp.array(mfi);
-            Array4<int const> const& msk = owner_mask->const_array(mfi);
-            AMREX_LOOP_3D(box, i, j, k,
-            {
-                if (!msk(i,j,k)) tag(i,j,k) = TagBox::CLEAR;
+            TagBitMask tmask(box);
+            tmask.set(tmp.const_array(mfi), [] (char t) { return t != TagBox::CLEAR; });
+            if (tmask.empty()) continue;
+            TagBitMask omask(box);
+            omask.set(owner_mask->const_array(mfi), [] (int m) { return m != 0; });
+            auto& tw = tmask.words();
+            auto const& ow = omask.words();
+            for (Long w = 0; w < tw.size(); ++w) {
+                tw[w] &= ~ow[w];
+            }
+            tmask.forEach([&] (int i, int j, int k) {
+                tag(i,j,k) = TagBox::CLEAR;
             });
         }
 
@@ -358,28 +593,102 @@ TagBoxArray::mapPeriodicRemoveDuplicates (const Geometry& geom)
     }
 }
 
+namespace {
+
+//
+// A bit-packed collate payload has a record for each FAB with tags:
+// the number of tags, the kind of record, the lower corner and the length
+// of the FAB box, and then either the tagged cells with their offsets
+// from the corner packed into one word, or the bit mask of the box,
+// whichever is smaller.
+//
+constexpr std::uint64_t TagRecordCells = 0;
+constexpr std::uint64_t TagRecordBits  = 1;
+constexpr int TagRecordHeader = 8;
+constexpr int TagCellBits = 21;
+
+void
+pack_tags (TagBitMask const& mask, Long ntags, Vector<std::uint64_t>& payload)
+{
+    const Dim3& lo  = mask.lo();
+    const Dim3& len = mask.len();
+    const bool cells_fit = len.x < (1 << TagCellBits) && len.y < (1 << TagCellBits)
+                                                       && len.z < (1 << TagCellBits);
+    const bool as_cells = cells_fit && ntags < mask.words().size();
+
+    payload.push_back(ntags);
+    payload.push_back(as_cells ? TagRecordCells : TagRecordBits);
+    for (int v : {lo.x, lo.y, lo.z, len.x, len.y, len.z}) {
+        payload.push_back(static_cast<std::uint64_t>(static_cast<std::int64_t>(v)));
+    }
+
+    if (as_cells) {
+        mask.forEach([&] (int i, int j, int k) {
+            payload.push_back( static_cast<std::uint64_t>(i-lo.x)
+                            | (static_cast<std::uint64_t>(j-lo.y) <<   TagCellBits)
+                            | (static_cast<std::uint64_t>(k-lo.z) << 2*TagCellBits));
+        });
+    } else {
+        payload.insert(payload.end(), mask.words().begin(), mask.words().end());
+    }
+}
+
+void
+unpack_tags (std::uint64_t const* p, std::uint64_t const* pend, Vector<IntVect>& v)
+{
+    constexpr std::uint64_t cell_mask = (std::uint64_t(1) << TagCellBits) - 1;
+    while (p < pend)
+    {
+        const Long ntags = static_cast<Long>(p[0]);
+        const std::uint64_t kind = p[1];
+        auto corner = [&] (int n) { return static_cast<int>(static_cast<std::int64_t>(p[2+n])); };
+        Box bx(IntVect(AMREX_D_DECL(corner(0),corner(1),corner(2))),
+               IntVect(AMREX_D_DECL(corner(0)+corner(3)-1,
+                                    corner(1)+corner(4)-1,
+                                    corner(2)+corner(5)-1)));
+        const Dim3 lo{corner(0), corner(1), corner(2)};
+        p += TagRecordHeader;
+        if (kind == TagRecordCells) {
+            for (Long n = 0; n < ntags; ++n, ++p) {
+                const int i = lo.x + static_cast<int>( *p                      & cell_mask);
+                const int j = lo.y + static_cast<int>((*p >>   TagCellBits)    & cell_mask);
+                const int k = lo.z + static_cast<int>((*p >> 2*TagCellBits)    & cell_mask);
+                amrex::ignore_unused(j,k);
+                v.push_back(IntVect(AMREX_D_DECL(i,j,k)));
+            }
+        } else {
+            TagBitMask mask(bx);
+            std::copy(p, p+mask.words().size(), mask.words().begin());
+            p += mask.words().size();
+            mask.forEach([&] (int i, int j, int k) {
+                amrex::ignore_unused(j,k);
+                v.push_back(IntVect(AMREX_D_DECL(i,j,k)));
+            });
+        }
+    }
+}
+
+}
+
 void
 TagBoxArray::local_collate_cpu (Vector<IntVect>& v) const
 {
     if (this->local_size() == 0) return;
 
-    Vector<int> count(this->local_size());
+    Vector<std::unique_ptr<TagBitMask> > masks(this->local_size());
+    Vector<Long> count(this->local_size());
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
     for (MFIter fai(*this); fai.isValid(); ++fai)
     {
-        Array4<char const> const& arr = this->const_array(fai);
-        Box const& bx = fai.fabbox();
-        int c = 0;
-        AMREX_LOOP_3D(bx,i,j,k,
-        {
-            if (arr(i,j,k) != TagBox::CLEAR) ++c;
-        });
-        count[fai.LocalIndex()] = c;
+        const int li = fai.LocalIndex();
+        masks[li].reset(new TagBitMask(fai.fabbox()));
+        masks[li]->set(this->const_array(fai), [] (char t) { return t != TagBox::CLEAR; });
+        count[li] = masks[li]->count();
     }
 
-    Vector<int> offset(count.size()+1, 0);
+    Vector<Long> offset(count.size()+1, 0);
     std::partial_sum(count.begin(), count.end(), offset.begin()+1);
 
     v.resize(offset.back());
@@ -387,23 +696,48 @@ TagBoxArray::local_collate_cpu (Vector<IntVect>& v) const
     if (v.empty()) return;
 
 #ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int li = 0; li < masks.size(); ++li)
+    {
+        IntVect* p = v.data() + offset[li];
+        masks[li]->forEach([&] (int i, int j, int k) {
+            amrex::ignore_unused(j,k);
+            *p++ = IntVect(AMREX_D_DECL(i,j,k));
+        });
+    }
+}
+
+void
+TagBoxArray::local_collate_packed (Vector<std::uint64_t>& payload, Long& ntags) const
+{
+    payload.clear();
+    ntags = 0;
+
+    // ---- the records of the FABs are made in parallel and then appended in FAB order
+    Vector<Vector<std::uint64_t> > records(this->local_size());
+    Vector<Long> count(this->local_size(), 0);
+#ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
     for (MFIter fai(*this); fai.isValid(); ++fai)
     {
-        int li = fai.LocalIndex();
+        const int li = fai.LocalIndex();
+        TagBitMask mask(fai.fabbox());
+        mask.set(this->const_array(fai), [] (char t) { return t != TagBox::CLEAR; });
+        count[li] = mask.count();
         if (count[li] > 0) {
-            IntVect* p = v.data() + offset[li];
-            Array4<char const> const& arr = this->const_array(fai);
-            Box const& bx = fai.fabbox();
-            AMREX_LOOP_3D(bx,i,j,k,
-            {
-                if (arr(i,j,k) != TagBox::CLEAR) {
-                    *p++ = IntVect(AMREX_D_DECL(i,j,k));
-                }
-            });
+            pack_tags(mask, count[li], records[li]);
         }
     }
+
+    std::size_t nwords = 0;
+    for (auto const& r : records) { nwords += r.size(); }
+    payload.reserve(nwords);
+    for (int li = 0; li < records.size(); ++li) {
+        payload.insert(payload.end(), records[li].begin(), records[li].end());
+        ntags += count[li];
+    }
 }
 
 #ifdef AMREX_USE_GPU
@@ -580,17 +914,21 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
     BL_PROFILE("TagBoxArray::collate()");
 
     Vector<IntVect> TheLocalCollateSpace;
+    Vector<std::uint64_t> payload;
+    Long count = 0;
 #ifdef AMREX_USE_GPU
-    if (Gpu::inLaunchRegion()) {
+    const bool packed = Gpu::notInLaunchRegion();
+    if (!packed) {
         local_collate_gpu(TheLocalCollateSpace);
+        count = TheLocalCollateSpace.size();
     } else
+#else
+    const bool packed = true;
 #endif
     {
-        local_collate_cpu(TheLocalCollateSpace);
+        local_collate_packed(payload, count);
     }
 
-    Long count = TheLocalCollateSpace.size();
-
     //
     // The total number of tags system wide that must be collated.
     //
@@ -606,6 +944,39 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
     }
 
 #ifdef BL_USE_MPI
+    const int IOProcNumber = ParallelDescriptor::IOProcessorNumber();
+
+    if (packed)
+    {
+        AMREX_ALWAYS_ASSERT(payload.size() <= static_cast<Long>(std::numeric_limits<int>::max()));
+        //
+        // Tell root CPU how long the payload of each CPU is and gather them.
+        //
+        const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(payload.size()),
+                                                                      IOProcNumber);
+        std::vector<int> offset(countvec.size(),0);
+        Vector<std::uint64_t> allpayload(1);
+        if (ParallelDescriptor::IOProcessor()) {
+            for (int i = 1, N = offset.size(); i < N; i++) {
+                offset[i] = offset[i-1] + countvec[i-1];
+            }
+            allpayload.resize(std::max(offset.back() + countvec.back(), 1));
+        }
+        const std::uint64_t* psend = payload.empty() ? nullptr : payload.data();
+        ParallelDescriptor::Gatherv(psend, static_cast<int>(payload.size()),
+                                    allpayload.data(), countvec, offset, IOProcNumber);
+
+        TheGlobalCollateSpace.clear();
+        if (ParallelDescriptor::IOProcessor()) {
+            TheGlobalCollateSpace.reserve(numtags);
+            unpack_tags(allpayload.data(), allpayload.data() + offset.back() + countvec.back(),
+                        TheGlobalCollateSpace);
+        } else {
+            TheGlobalCollateSpace.resize(1);
+        }
+        return;
+    }
+
     //
     // On I/O proc. this holds all tags after they've been gather'd.
     // On other procs. non-mempty signals size is not zero.
@@ -619,7 +990,6 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
     //
     // Tell root CPU how many tags each CPU will be sending.
     //
-    const int IOProcNumber = ParallelDescriptor::IOProcessorNumber();
     const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(count),
                                                                   IOProcNumber);
     std::vector<int> offset(countvec.size(),0);
@@ -636,7 +1006,13 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
     ParallelDescriptor::Gatherv(psend, count, precv, countvec, offset, IOProcNumber);
 
 #else
-    TheGlobalCollateSpace = std::move(TheLocalCollateSpace);
+    if (packed) {
+        TheGlobalCollateSpace.clear();
+        TheGlobalCollateSpace.reserve(numtags);
+        unpack_tags(payload.data(), payload.data() + payload.size(), TheGlobalCollateSpace);
+    } else {
+        TheGlobalCollateSpace = std::move(TheLocalCollateSpace);
+    }
 #endif
 }
 
@@ -6,6 +6,8 @@
 #include <AMReX_Utility.H>
 #include <AMReX.H>
 
+#include <atomic>
+
 namespace amrex {
 namespace AsyncOut {
 
@@ -25,6 +27,8 @@ std::unique_ptr<BackgroundThread> s_thread;
 
 WriteInfo s_info;
 
+std::atomic<Long> s_staged_bytes{0};
+
 }
 
 void Initialize ()
@@ -112,6 +116,16 @@ void Finish ()
     s_thread->Finish();
 }
 
+void AddStagedBytes (Long nbytes)
+{
+    s_staged_bytes += nbytes;
+}
+
+Long StagedBytes ()
+{
+    return s_staged_bytes.load();
+}
+
 void Wait ()
 {
 #ifdef AMREX_USE_MPI
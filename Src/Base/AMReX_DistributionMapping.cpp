@@ -1842,6 +1842,58 @@ DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, const int np
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeKeepingOwners (const BoxArray& ba,
+                                        const BoxArray& old_ba,
+                                        const DistributionMapping& old_dm)
+{
+    BL_PROFILE("makeKeepingOwners");
+
+    const int nprocs = ParallelContext::NProcsSub();
+    const int N = ba.size();
+
+    Vector<int> pmap(N, -1);
+    Vector<Long> load(nprocs, 0);
+    Vector<LIpair> rest;
+
+    std::vector< std::pair<int,Box> > isects;
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = ba[i];
+        old_ba.intersections(bx, isects);
+        for (auto const& is : isects) {
+            if (old_ba[is.first] == bx) {
+                pmap[i] = old_dm[is.first];
+                load[pmap[i]] += bx.numPts();
+                break;
+            }
+        }
+        if (pmap[i] < 0) {
+            rest.push_back(LIpair(bx.numPts(), i));
+        }
+    }
+
+    std::stable_sort(rest.begin(), rest.end(),
+                     [] (LIpair const& a, LIpair const& b) { return a.first > b.first; });
+
+    // Min-heap of (load, process)
+    std::priority_queue<LIpair, std::vector<LIpair>, std::greater<LIpair> > pq;
+    for (int i = 0; i < nprocs; ++i) {
+        pq.push(LIpair(load[i], i));
+    }
+
+    for (auto const& r : rest)
+    {
+        LIpair top = pq.top();
+        pq.pop();
+        pmap[r.second] = top.second;
+        top.first += r.first;
+        pq.push(top);
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
 const Vector<int>&
 DistributionMapping::getIndexArray ()
 {
@@ -25,6 +25,8 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 int     FabArrayBase::MaxComp;
+bool    FabArrayBase::CacheFillPatchBuffers;
+bool    FabArrayBase::SkipCoveredBoxes;
 
 #if defined(AMREX_USE_GPU)
 
@@ -69,6 +71,7 @@ FabArrayBase::CacheStats           FabArrayBase::m_TAC_stats("TileArrayCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FBC_stats("FBCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CPC_stats("CopyCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FPinfo_stats("FillPatchCache");
+FabArrayBase::CacheStats           FabArrayBase::m_FPbuf_stats("FillPatchBufferCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CFinfo_stats("CrseFineCache");
 
 std::map<FabArrayBase::BDKey, int> FabArrayBase::m_BD_count;
@@ -94,6 +97,8 @@ FabArrayBase::Initialize ()
     // Set default values here!!!
     //
     FabArrayBase::MaxComp           = 25;
+    FabArrayBase::CacheFillPatchBuffers = true;
+    FabArrayBase::SkipCoveredBoxes  = false;
 
     ParmParse pp("fabarray");
 
@@ -115,6 +120,8 @@ FabArrayBase::Initialize ()
     }
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
+    pp.query("cache_fillpatch_buffers", FabArrayBase::CacheFillPatchBuffers);
+    pp.query("skip_covered_boxes", FabArrayBase::SkipCoveredBoxes);
 
     if (MaxComp < 1) {
         MaxComp = 1;
@@ -224,6 +231,7 @@ FabArrayBase::clear ()
     indexArray.clear();
     ownership.clear();
     m_bdkey = BDKey();
+    m_covered_boxes.reset();
 }
 
 Box
@@ -302,6 +310,8 @@ FabArrayBase::CPC::CPC (const FabArrayBase& dstfa, const IntVect& dstng,
       m_period(period),
       m_srcba(srcfa.boxArray()),
       m_dstba(dstfa.boxArray()),
+      m_src_covered(srcfa.m_covered_boxes),
+      m_dst_covered(dstfa.m_covered_boxes),
       m_nuse(0)
 {
     this->define(m_dstba, dstfa.DistributionMap(), dstfa.IndexArray(),
@@ -355,6 +365,15 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
 
         const std::vector<IntVect>& pshifts = m_period.shiftIntVect();
 
+        // Copies from a box that is all covered to another one are skipped.
+        const Vector<char>* src_covered = (m_src_covered && m_dst_covered)
+            ? m_src_covered.get() : nullptr;
+        const Vector<char>* dst_covered = (m_src_covered && m_dst_covered)
+            ? m_dst_covered.get() : nullptr;
+        auto skip = [=] (int k_src, int k_dst) -> bool {
+            return src_covered && (*src_covered)[k_src] && (*dst_covered)[k_dst];
+        };
+
         auto& send_tags = *m_SndTags;
 
         for (int i = 0; i < nlocal_src; ++i)
@@ -372,7 +391,9 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
                     const Box& bx       = isects[j].second;
                     const int dst_owner = dm_dst[k_dst];
 
-                    if (ParallelDescriptor::sameTeam(dst_owner)) {
+                    if (skip(k_src, k_dst)) {
+                        continue;
+                    } else if (ParallelDescriptor::sameTeam(dst_owner)) {
                         continue; // local copy will be dealt with later
                     } else if (MyProc == dm_src[k_src]) {
                         send_tags[dst_owner].push_back(CopyComTag(bx, bx-(*pit), k_dst, k_src));
@@ -427,7 +448,9 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
                     const Box& bx       = isects[j].second - *pit;
                     const int src_owner = dm_src[k_src];
 
-                    if (ParallelDescriptor::sameTeam(src_owner, MyProc)) { // local copy
+                    if (skip(k_src, k_dst)) {
+                        continue;
+                    } else if (ParallelDescriptor::sameTeam(src_owner, MyProc)) { // local copy
                         const BoxList tilelist(bx, FabArrayBase::comm_tile_size);
                         for (BoxList::const_iterator
                                  it_tile  = tilelist.begin(),
@@ -597,7 +620,9 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
             it->second->m_dstbdk == dstkey &&
             it->second->m_period == period &&
             it->second->m_srcba  == src.boxArray() &&
-            it->second->m_dstba  == boxArray())
+            it->second->m_dstba  == boxArray()     &&
+            it->second->m_src_covered == src.m_covered_boxes &&
+            it->second->m_dst_covered == m_covered_boxes)
         {
             ++(it->second->m_nuse);
             m_CPC_stats.recordUse();
@@ -635,7 +660,7 @@ FabArrayBase::FB::FB (const FabArrayBase& fa, const IntVect& nghost,
     : m_typ(fa.boxArray().ixType()), m_crse_ratio(fa.boxArray().crseRatio()),
       m_ngrow(nghost), m_cross(cross),
       m_epo(enforce_periodicity_only), m_period(period),
-      m_nuse(0), m_multi_ghost(multi_ghost)
+      m_nuse(0), m_multi_ghost(multi_ghost), m_covered_boxes(fa.m_covered_boxes)
 {
     BL_PROFILE("FabArrayBase::FB::FB()");
 
@@ -673,11 +698,15 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
 
     const std::vector<IntVect>& pshifts = m_period.shiftIntVect();
 
+    // Ghost cells are not filled from boxes that are all covered.
+    const Vector<char>* covered = m_covered_boxes.get();
+
     auto& send_tags = *m_SndTags;
 
     for (int i = 0; i < nlocal; ++i)
     {
         const int ksnd = imap[i];
+        if (covered && (*covered)[ksnd]) continue;
         const Box& vbx = ba[ksnd];
         const Box& vbx_ng  = amrex::grow(vbx,1);
 
@@ -763,6 +792,8 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
                 const Box& dst_bx   = isects[j].second - *pit;
                 const int src_owner = dm[ksnd];
 
+                if (covered && (*covered)[ksnd]) continue;
+
                 BoxList bl = amrex::boxDiff(dst_bx, vbx);
 
                 if (m_multi_ghost)
@@ -902,9 +933,12 @@ FabArrayBase::FB::define_epo (const FabArrayBase& fa)
     Box pdomain = m_period.Domain();
     pdomain.convert(typ);
 
+    const Vector<char>* covered = m_covered_boxes.get();
+
     for (int i = 0; i < nlocal; ++i)
     {
         const int ksnd = imap[i];
+        if (covered && (*covered)[ksnd]) continue;
         Box bxsnd = amrex::grow(ba[ksnd],ng);
         bxsnd &= pdomain; // source must be inside the periodic domain.
 
@@ -986,6 +1020,8 @@ FabArrayBase::FB::define_epo (const FabArrayBase& fa)
                     const Box& dst_bx   = isects[j].second - *pit;
                     const int src_owner = dm[ksnd];
 
+                    if (covered && (*covered)[ksnd]) continue;
+
                     const BoxList& bl = amrex::boxDiff(dst_bx, pdomain);
 
                     for (BoxList::const_iterator lit = bl.begin(); lit != bl.end(); ++lit)
@@ -1091,7 +1127,8 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
             it->second->m_cross      == cross                    &&
             it->second->m_multi_ghost== m_multi_ghost            &&
             it->second->m_epo        == enforce_periodicity_only &&
-            it->second->m_period     == period              )
+            it->second->m_period     == period                   &&
+            it->second->m_covered_boxes == m_covered_boxes       )
         {
             ++(it->second->m_nuse);
             m_FBC_stats.recordUse();
@@ -1819,6 +1856,9 @@ FabArrayBase::FPinfo::FPinfo (const FabArrayBase& srcfa,
 
 FabArrayBase::FPinfo::~FPinfo ()
 {
+    if (m_crse_patch_buf) {
+        m_FPbuf_stats.recordErase(m_buf_nuse);
+    }
 }
 
 Long
@@ -2082,6 +2122,7 @@ FabArrayBase::Finalize ()
         m_FBC_stats.print();
         m_CPC_stats.print();
         m_FPinfo_stats.print();
+        m_FPbuf_stats.print();
         m_CFinfo_stats.print();
     }
 
@@ -2090,10 +2131,17 @@ FabArrayBase::Finalize ()
     }
     m_region_tag.clear();
 
+    // The FillPatch buffers are FabArrays.  Free them while the arenas are still alive.
+    for (auto& kv : m_TheFillPatchCache) {
+        kv.second->m_crse_patch_buf.reset();
+        kv.second->m_fine_patch_buf.reset();
+    }
+
     m_TAC_stats = CacheStats("TileArrayCache");
     m_FBC_stats = CacheStats("FBCache");
     m_CPC_stats = CacheStats("CopyCache");
     m_FPinfo_stats = CacheStats("FillPatchCache");
+    m_FPbuf_stats = CacheStats("FillPatchBufferCache");
     m_CFinfo_stats = CacheStats("CrseFineCache");
 
     m_BD_count.clear();
@@ -2102,6 +2150,9 @@ FabArrayBase::Finalize ()
 
     the_fa_arena = nullptr;
 
+    CacheFillPatchBuffers = true;
+    SkipCoveredBoxes = false;
+
     initialized = false;
 }
 
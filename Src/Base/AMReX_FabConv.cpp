@@ -3,6 +3,9 @@
 #include <cstdlib>
 #include <limits>
 #include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
 
 #include <AMReX.H>
 #include <AMReX_FabConv.H>
@@ -14,6 +17,7 @@
 namespace amrex {
 
 bool RealDescriptor::bAlwaysFixDenormals (false);
+bool RealDescriptor::bFastIEEEConversion (true);
 int  RealDescriptor::writeBufferSize(262144);  // ---- these are number of reals,
 int  RealDescriptor::readBufferSize(262144);   // ---- not bytes
 
@@ -151,6 +155,18 @@ RealDescriptor::SetFixDenormals()
     bAlwaysFixDenormals = true;
 }
 
+void
+RealDescriptor::SetFastIEEEConversion (bool fast)
+{
+    bFastIEEEConversion = fast;
+}
+
+bool
+RealDescriptor::FastIEEEConversion ()
+{
+    return bFastIEEEConversion;
+}
+
 void
 RealDescriptor::SetReadBufferSize(int rbs)
 {
@@ -779,6 +795,188 @@ PD_fconvert (void*       out,
     _pd_reorder((char*)out, nitems, outbytes, outord);
 }
 
+//
+// Fast paths for IEEE floats and doubles stored in the native or the
+// reversed byte order.  They work on whole words, so the loops below can be
+// vectorized by the compiler, and give the same bits as PD_fconvert
+// followed by PD_fixdenormals: words with a zero exponent become +0,
+// narrowing truncates the mantissa and overflows to +-inf, and widening
+// maps the exponent of inf and NaN like that of any other number.
+//
+
+//
+// Returns 1 if the format is IEEE float or double in the native byte order,
+// -1 if it is in the reversed byte order, and 0 otherwise.
+//
+
+static
+int
+ieee_byte_order (const Long* fmt,
+                 const int*  ord)
+{
+    int        nbytes;
+    const int* native_ord;
+    if (std::equal(fmt, fmt+8, FPC::ieee_float)) {
+        nbytes     = 4;
+        native_ord = FPC::Native32RealDescriptor().order();
+    } else if (std::equal(fmt, fmt+8, FPC::ieee_double)) {
+        nbytes     = 8;
+        native_ord = FPC::Native64RealDescriptor().order();
+    } else {
+        return 0;
+    }
+    if (std::equal(ord, ord+nbytes, native_ord)) {
+        return 1;
+    } else if (std::equal(ord, ord+nbytes, std::reverse_iterator<const int*>(native_ord+nbytes))) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
+
+static inline
+std::uint32_t
+ieee_swap_word (std::uint32_t w)
+{
+    w = ((w << 8) & 0xFF00FF00U) | ((w >> 8) & 0x00FF00FFU);
+    return (w << 16) | (w >> 16);
+}
+
+static inline
+std::uint64_t
+ieee_swap_word (std::uint64_t w)
+{
+    w = ((w <<  8) & 0xFF00FF00FF00FF00ULL) | ((w >>  8) & 0x00FF00FF00FF00FFULL);
+    w = ((w << 16) & 0xFFFF0000FFFF0000ULL) | ((w >> 16) & 0x0000FFFF0000FFFFULL);
+    return (w << 32) | (w >> 32);
+}
+
+template <typename T>
+static
+void
+ieee_swap_words (void*       out,
+                 const void* in,
+                 Long        nitems)
+{
+    auto pin  = static_cast<const char*>(in);
+    auto pout = static_cast<char*>(out);
+    for (Long i = 0; i < nitems; ++i) {
+        T w;
+        std::memcpy(&w, pin+i*sizeof(T), sizeof(T));
+        w = ieee_swap_word(w);
+        std::memcpy(pout+i*sizeof(T), &w, sizeof(T));
+    }
+}
+
+template <bool SwapIn, bool SwapOut>
+static
+void
+ieee_float_to_double (void*       out,
+                      const void* in,
+                      Long        nitems)
+{
+    auto pin  = static_cast<const char*>(in);
+    auto pout = static_cast<char*>(out);
+    for (Long i = 0; i < nitems; ++i) {
+        std::uint32_t w;
+        std::memcpy(&w, pin+i*sizeof(w), sizeof(w));
+        if (SwapIn) { w = ieee_swap_word(w); }
+        const std::uint64_t e = (w >> 23) & 0xFFU;
+        std::uint64_t r = (std::uint64_t(w & 0x80000000U) << 32)
+            | ((e + (1023-127)) << 52)
+            | (std::uint64_t(w & 0x007FFFFFU) << 29);
+        r = (e == 0) ? std::uint64_t(0) : r;
+        if (SwapOut) { r = ieee_swap_word(r); }
+        std::memcpy(pout+i*sizeof(r), &r, sizeof(r));
+    }
+}
+
+template <bool SwapIn, bool SwapOut>
+static
+void
+ieee_double_to_float (void*       out,
+                      const void* in,
+                      Long        nitems)
+{
+    auto pin  = static_cast<const char*>(in);
+    auto pout = static_cast<char*>(out);
+    for (Long i = 0; i < nitems; ++i) {
+        std::uint64_t w;
+        std::memcpy(&w, pin+i*sizeof(w), sizeof(w));
+        if (SwapIn) { w = ieee_swap_word(w); }
+        const std::int64_t  e = std::int64_t((w >> 52) & 0x7FFU) - (1023-127);
+        const std::uint32_t s = std::uint32_t(w >> 32) & 0x80000000U;
+        const std::uint32_t m = std::uint32_t(w >> 29) & 0x007FFFFFU;
+        std::uint32_t r = (e >= 0xFF) ? (s | 0x7F800000U)
+            : ((e > 0) ? (s | (std::uint32_t(e) << 23) | m) : std::uint32_t(0));
+        if (SwapOut) { r = ieee_swap_word(r); }
+        std::memcpy(pout+i*sizeof(r), &r, sizeof(r));
+    }
+}
+
+template <typename T>
+static
+void
+ieee_fixdenormals (void* out,
+                   Long  nitems,
+                   T     expmask)
+{
+    auto pout = static_cast<char*>(out);
+    for (Long i = 0; i < nitems; ++i) {
+        T w;
+        std::memcpy(&w, pout+i*sizeof(T), sizeof(T));
+        w = (w & expmask) ? w : T(0);
+        std::memcpy(pout+i*sizeof(T), &w, sizeof(T));
+    }
+}
+
+//
+// Converts between IEEE formats with the fast paths above.  Returns false,
+// without touching out, if either format is not one they handle.
+//
+
+static
+bool
+PD_convert_ieee (void*                 out,
+                 const void*           in,
+                 Long                  nitems,
+                 const RealDescriptor& ord,
+                 const RealDescriptor& ird)
+{
+    const int oo = ieee_byte_order(ord.format(), ord.order());
+    const int io = ieee_byte_order(ird.format(), ird.order());
+    if (oo == 0 || io == 0) { return false; }
+
+    const int ob = ord.numBytes();
+    const int ib = ird.numBytes();
+    if (ob == ib && oo == io) {
+        std::memcpy(out, in, size_t(nitems)*ob);
+    } else if (ob == ib) {
+        if (ob == 4) {
+            ieee_swap_words<std::uint32_t>(out, in, nitems);
+        } else {
+            ieee_swap_words<std::uint64_t>(out, in, nitems);
+        }
+    } else if (ib == 4) {
+        if (io > 0) {
+            if (oo > 0) { ieee_float_to_double<false,false>(out, in, nitems); }
+            else        { ieee_float_to_double<false,true >(out, in, nitems); }
+        } else {
+            if (oo > 0) { ieee_float_to_double<true ,false>(out, in, nitems); }
+            else        { ieee_float_to_double<true ,true >(out, in, nitems); }
+        }
+    } else {
+        if (io > 0) {
+            if (oo > 0) { ieee_double_to_float<false,false>(out, in, nitems); }
+            else        { ieee_double_to_float<false,true >(out, in, nitems); }
+        } else {
+            if (oo > 0) { ieee_double_to_float<true ,false>(out, in, nitems); }
+            else        { ieee_double_to_float<true ,true >(out, in, nitems); }
+        }
+    }
+    return true;
+}
+
 static
 void
 PD_fixdenormals (void*       out,
@@ -787,6 +985,21 @@ PD_fixdenormals (void*       out,
                  const int*  outord)
 {
 //    BL_PROFILE("PD_fixdenormals");
+    if (RealDescriptor::FastIEEEConversion())
+    {
+        const int oo = ieee_byte_order(outfor, outord);
+        if (oo != 0) {
+            if (outfor[0] == 32) {
+                const std::uint32_t m = 0x7F800000U;
+                ieee_fixdenormals(out, nitems, (oo > 0) ? m : ieee_swap_word(m));
+            } else {
+                const std::uint64_t m = 0x7FF0000000000000ULL;
+                ieee_fixdenormals(out, nitems, (oo > 0) ? m : ieee_swap_word(m));
+            }
+            return;
+        }
+    }
+
     const int nbo = int(outfor[0]);
 
     int nbo_exp  = int(outfor[1]);
@@ -924,10 +1137,6 @@ PD_convert (void*                 out,
         BL_ASSERT(int(n) == nitems);
         memcpy(out, in, n*ord.numBytes());
     }
-    else if (ord.formatarray() == ird.formatarray() && boffs == 0 && ! onescmp) {
-        permute_real_word_order(out, in, nitems,
-                                ord.order(), ird.order(), ord.numBytes());
-    }
     else if (ird == FPC::NativeRealDescriptor() && ord == FPC::Native32RealDescriptor()) {
       auto rIn = static_cast<const char*>(in);
       auto rOut= static_cast<char*>(out);
@@ -941,6 +1150,17 @@ PD_convert (void*                 out,
         rIn += sizeof(Real);
       }
     }
+    else if (boffs == 0 && ! onescmp && RealDescriptor::FastIEEEConversion() &&
+             PD_convert_ieee(out, in, nitems, ord, ird))
+    {
+        //
+        // Byte swapped or widened/narrowed IEEE data; nothing more to do.
+        //
+    }
+    else if (ord.formatarray() == ird.formatarray() && boffs == 0 && ! onescmp) {
+        permute_real_word_order(out, in, nitems,
+                                ord.order(), ird.order(), ord.numBytes());
+    }
     else
     {
         PD_fconvert(out, in, nitems, boffs, ord.format(), ord.order(),
@@ -1,6 +1,7 @@
 
 #include <AMReX_MFIter.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_LayoutData.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_OpenMP.H>
 
@@ -10,6 +11,10 @@ int MFIter::nextDynamicIndex = std::numeric_limits<int>::min();
 int MFIter::depth = 0;
 int MFIter::allow_multiple_mfiters = 0;
 
+LayoutData<Real>* MFIter::cost_target = nullptr;
+bool MFIter::cost_tagged_only = false;
+int  MFIter::cost_region_depth = 0;
+
 int
 MFIter::allowMultipleMFIters (int allow)
 {
@@ -17,6 +22,28 @@ MFIter::allowMultipleMFIters (int allow)
     return allow;
 }
 
+LayoutData<Real>*
+MFIter::setCostTarget (LayoutData<Real>* cost, bool tagged_only) noexcept
+{
+    std::swap(cost, cost_target);
+    cost_tagged_only = tagged_only;
+    return cost;
+}
+
+MFIter::CostRegion::CostRegion () noexcept
+{
+    // The depth is read by all threads, so it must not change inside a
+    // parallel region.
+    AMREX_ASSERT_WITH_MESSAGE(!OpenMP::in_parallel(),
+                              "MFIter::CostRegion must be created outside OpenMP parallel regions");
+    ++cost_region_depth;
+}
+
+MFIter::CostRegion::~CostRegion ()
+{
+    --cost_region_depth;
+}
+
 MFIter::MFIter (const FabArrayBase& fabarray_,
                 unsigned char       flags_)
     :
@@ -349,9 +376,35 @@ MFIter::Initialize ()
 #endif
 
         typ = fabArray.boxArray().ixType();
+
+        if (cost_target && (!cost_tagged_only || cost_region_depth > 0)
+            && fabArray.DistributionMap() == cost_target->DistributionMap()
+            && fabArray.boxArray().CellEqual(cost_target->boxArray()))
+        {
+            m_cost = cost_target;
+#ifdef AMREX_USE_GPU
+            Gpu::streamSynchronize();
+#endif
+            m_cost_time = amrex::second();
+        }
     }
 }
 
+void
+MFIter::addCost () noexcept
+{
+#ifdef AMREX_USE_GPU
+    Gpu::streamSynchronize();
+#endif
+    const double t = amrex::second();
+    Real& c = (*m_cost)[*this];
+#ifdef AMREX_USE_OMP
+#pragma omp atomic
+#endif
+    c += static_cast<Real>(t - m_cost_time);
+    m_cost_time = t;
+}
+
 Box
 MFIter::tilebox () const noexcept
 {
@@ -492,6 +545,8 @@ MFIter::grownnodaltilebox (int dir, IntVect const& a_ng) const noexcept
 void
 MFIter::operator++ () noexcept
 {
+    if (m_cost && isValid()) addCost();
+
 #ifdef AMREX_USE_OMP
     if (dynamic)
     {
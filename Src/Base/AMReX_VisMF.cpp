@@ -10,6 +10,11 @@
 #include <array>
 #include <memory>
 #include <numeric>
+#include <future>
+#include <map>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
 
 #include <AMReX_ccse-mpi.H>
 #include <AMReX_Utility.H>
@@ -25,6 +30,7 @@ namespace amrex {
 static const char *TheMultiFabHdrFileSuffix = "_H";
 static const char *FabFileSuffix = "_D_";
 static const char *TheFabOnDiskPrefix = "FabOnDisk:";
+static const char *TheFabHashTag = "FabHashes:";
 
 std::map<std::string, VisMF::PersistentIFStream> VisMF::persistentIFStreams;
 
@@ -37,6 +43,9 @@ bool VisMF::useSingleWrite(false);
 bool VisMF::checkFilePositions(false);
 bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
+bool VisMF::useAggregatedReads(false);
+int  VisMF::nAggregators(0);
+Long VisMF::aggregatedReadSize(64*1024*1024);
 bool VisMF::useDynamicSetSelection(true);
 bool VisMF::allowSparseWrites(true);
 
@@ -84,6 +93,9 @@ VisMF::Initialize ()
     pp.query("checkfilepositions", checkFilePositions);
     pp.query("usepersistentifstreams", usePersistentIFStreams);
     pp.query("usesynchronousreads", useSynchronousReads);
+    pp.query("useaggregatedreads", useAggregatedReads);
+    pp.query("naggregators", nAggregators);
+    pp.query("aggregatedreadsize", aggregatedReadSize);
     pp.query("usedynamicsetselection", useDynamicSetSelection);
     pp.query("iobuffersize", ioBufferSize);
     pp.query("allowsparsewrites", allowSparseWrites);
@@ -259,10 +271,303 @@ operator>> (std::istream&         is,
     return is;
 }
 
+namespace {
+
+//
+// NoFabHeaderBinary_v1 headers start with the usual fields in ASCII, then
+// the FabArray min and max values, the names of the data files and the
+// number of boxes.  These are followed by a magic number to check the byte
+// order, the boxes in binary, and one fixed size record for each FAB that
+// holds its offset, the index of its data file in the list of names and
+// its min and max values.  The records are written by the processes that
+// write the FABs and read only by the processes that need them.
+//
+const std::uint32_t TheBinaryHeaderMagic = 0x56495346;
+
+Long
+BinaryRecordSize (int ncomp)
+{
+    return 2 * sizeof(std::int64_t) + 2 * Long(ncomp) * sizeof(double);
+}
+
+void
+PackBinaryRecord (char *p, const VisMF::Header &hd, int i, Long fileIndex)
+{
+    const std::int64_t head[2] = { hd.m_fod[i].m_head, fileIndex };
+    std::memcpy(p, head, sizeof(head));
+    auto *mm = reinterpret_cast<double *>(p + sizeof(head));
+    for(int j(0); j < hd.m_ncomp; ++j) {
+      const bool has_mm(i < hd.m_min.size() && j < hd.m_min[i].size());
+      mm[j]             = has_mm ? static_cast<double>(hd.m_min[i][j]) : 0.0;
+      mm[hd.m_ncomp+j]  = has_mm ? static_cast<double>(hd.m_max[i][j]) : 0.0;
+    }
+}
+
+void
+UnpackBinaryRecord (const char *p, VisMF::Header &hd, int i)
+{
+    std::int64_t head[2];
+    std::memcpy(head, p, sizeof(head));
+    if(head[1] < 0 || head[1] >= hd.m_fabFileNames.size()) {
+      amrex::Error("Bad data file index in VisMF::Header");
+    }
+    hd.m_fod[i].m_head = head[0];
+    hd.m_fod[i].m_name = hd.m_fabFileNames[head[1]];
+    hd.m_min[i].resize(hd.m_ncomp);
+    hd.m_max[i].resize(hd.m_ncomp);
+    const char *mm = p + sizeof(head);
+    for(int j(0); j < hd.m_ncomp; ++j) {
+      double vmin, vmax;
+      std::memcpy(&vmin, mm + j*sizeof(double), sizeof(double));
+      std::memcpy(&vmax, mm + (hd.m_ncomp+j)*sizeof(double), sizeof(double));
+      hd.m_min[i][j] = static_cast<Real>(vmin);
+      hd.m_max[i][j] = static_cast<Real>(vmax);
+    }
+}
+
+//
+// Everything before the records.  The file names are passed in because
+// they are only known to the writers before the data are written.
+//
+void
+WriteBinaryPrefix (std::ostream &os, const VisMF::Header &hd,
+                   const Vector<std::string> &fileNames)
+{
+    std::ios::fmtflags oflags = os.flags();
+    os.setf(std::ios::floatfield, std::ios::scientific);
+    int oldPrec(os.precision(16));
+
+    os << hd.m_vers     << '\n';
+    os << int(hd.m_how) << '\n';
+    os << hd.m_ncomp    << '\n';
+    if (hd.m_ngrow == hd.m_ngrow[0]) {
+        os << hd.m_ngrow[0] << '\n';
+    } else {
+        os << hd.m_ngrow    << '\n';
+    }
+
+    if(FArrayBox::getFormat() == FABio::FAB_NATIVE_32) {
+      os << FPC::Native32RealDescriptor() << '\n';
+    } else if(FArrayBox::getFormat() == FABio::FAB_IEEE_32) {
+      os << FPC::Ieee32NormalRealDescriptor() << '\n';
+    } else {
+      os << FPC::NativeRealDescriptor() << '\n';
+    }
+
+    for(int i(0); i < hd.m_ncomp; ++i) {
+      os << (i < hd.m_famin.size() ? hd.m_famin[i] :  std::numeric_limits<Real>::max()) << ',';
+    }
+    os << '\n';
+    for(int i(0); i < hd.m_ncomp; ++i) {
+      os << (i < hd.m_famax.size() ? hd.m_famax[i] : -std::numeric_limits<Real>::max()) << ',';
+    }
+    os << '\n';
+
+    os << fileNames.size() << '\n';
+    for(const auto &name : fileNames) {
+      os << name << '\n';
+    }
+
+    os << AMREX_SPACEDIM << ' ' << hd.m_ba.size() << ' ' << hd.m_ba.ixType().ixType() << '\n';
+
+    os.flags(oflags);
+    os.precision(oldPrec);
+
+    const std::uint32_t magic(TheBinaryHeaderMagic);
+    os.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+
+    const int nboxes(hd.m_ba.size());
+    std::vector<int> boxes(2*AMREX_SPACEDIM*std::min(nboxes, 65536));
+    for(int ib(0); ib < nboxes; ) {
+      const int n(std::min<int>(nboxes - ib, boxes.size() / (2*AMREX_SPACEDIM)));
+      for(int k(0); k < n; ++k) {
+        const Box &b = hd.m_ba[ib+k];
+        for(int d(0); d < AMREX_SPACEDIM; ++d) {
+          boxes[2*AMREX_SPACEDIM*k + d]                = b.smallEnd(d);
+          boxes[2*AMREX_SPACEDIM*k + AMREX_SPACEDIM + d] = b.bigEnd(d);
+        }
+      }
+      os.write(reinterpret_cast<const char *>(boxes.data()), 2*AMREX_SPACEDIM*n*sizeof(int));
+      ib += n;
+    }
+}
+
+//
+// Everything after m_ngrow.  The records are read if they are in the stream.
+//
+void
+ReadBinaryHeaderRest (std::istream &is, VisMF::Header &hd)
+{
+    is >> hd.m_writtenRD;
+
+    char ch;
+    hd.m_famin.resize(hd.m_ncomp);
+    hd.m_famax.resize(hd.m_ncomp);
+    for(int i(0); i < hd.m_famin.size(); ++i) {
+      is >> hd.m_famin[i] >> ch;
+      if( ch != ',' ) {
+        amrex::Error("Expected a ',' when reading hd.m_famin");
+      }
+    }
+    for(int i(0); i < hd.m_famax.size(); ++i) {
+      is >> hd.m_famax[i] >> ch;
+      if( ch != ',' ) {
+        amrex::Error("Expected a ',' when reading hd.m_famax");
+      }
+    }
+
+    int nfiles(0);
+    is >> nfiles;
+    hd.m_fabFileNames.resize(nfiles);
+    for(int i(0); i < nfiles; ++i) {
+      is >> hd.m_fabFileNames[i];
+    }
+
+    int ndims(0), nboxes(0);
+    IntVect ixtype;
+    is >> ndims >> nboxes >> ixtype;
+    is.get(ch);
+    if( ! is.good() || ch != '\n' || nboxes < 0) {
+      amrex::Error("Read of VisMF::Header failed");
+    }
+    if(ndims != AMREX_SPACEDIM) {
+      amrex::Error("VisMF::Header:  a NoFabHeaderBinary_v1 header must be read with the same AMREX_SPACEDIM");
+    }
+
+    std::uint32_t magic(0);
+    is.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    if(magic != TheBinaryHeaderMagic) {
+      amrex::Error("VisMF::Header:  bad NoFabHeaderBinary_v1 header or different byte order");
+    }
+
+    const IndexType boxType(ixtype);
+    BoxList bl(boxType);
+    bl.reserve(nboxes);
+    std::vector<int> boxes(2*AMREX_SPACEDIM*std::min(nboxes, 65536));
+    for(int ib(0); ib < nboxes; ) {
+      const int n(std::min<int>(nboxes - ib, boxes.size() / (2*AMREX_SPACEDIM)));
+      is.read(reinterpret_cast<char *>(boxes.data()), 2*AMREX_SPACEDIM*n*sizeof(int));
+      for(int k(0); k < n; ++k) {
+        const IntVect lo(&boxes[2*AMREX_SPACEDIM*k]);
+        const IntVect hi(&boxes[2*AMREX_SPACEDIM*k + AMREX_SPACEDIM]);
+        bl.push_back(Box(lo, hi, boxType));
+      }
+      ib += n;
+    }
+    if( ! is.good()) {
+      amrex::Error("Read of VisMF::Header boxes failed");
+    }
+    hd.m_ba = BoxArray(std::move(bl));
+    hd.m_recordsOffset = static_cast<std::streamoff>(is.tellg());
+
+    hd.m_fod.clear();
+    hd.m_fod.resize(nboxes);
+    hd.m_min.clear();
+    hd.m_min.resize(nboxes);
+    hd.m_max.clear();
+    hd.m_max.resize(nboxes);
+    hd.m_hash.clear();
+
+    if(is.peek() == std::char_traits<char>::eof()) {  // ---- the records are read later
+      is.clear();
+      return;
+    }
+
+    const Long recordSize(BinaryRecordSize(hd.m_ncomp));
+    std::vector<char> records(recordSize*std::min(nboxes, 65536));
+    for(int ib(0); ib < nboxes; ) {
+      const int n(std::min<int>(nboxes - ib, records.size() / recordSize));
+      is.read(records.data(), n*recordSize);
+      for(int k(0); k < n; ++k) {
+        UnpackBinaryRecord(records.data() + k*recordSize, hd, ib+k);
+      }
+      ib += n;
+    }
+    if( ! is.good()) {
+      amrex::Error("Read of VisMF::Header records failed");
+    }
+
+    is >> std::ws;
+    if(is.good() && is.peek() == TheFabHashTag[0]) {
+      std::string tag;
+      int nhash(0);
+      is >> tag >> nhash;
+      if(tag != TheFabHashTag || nhash != nboxes) {
+        amrex::Error("Bad FAB hashes in VisMF::Header");
+      }
+      hd.m_hash.resize(nhash);
+      for(int i(0); i < nhash; ++i) {
+        is >> hd.m_hash[i];
+      }
+    }
+    is.clear();
+}
+
+//
+// The length of everything before the records, from the ASCII lines.
+//
+Long
+BinaryHeaderPrefixLength (std::istream &is)
+{
+    std::string line;
+    for(int i(0); i < 7; ++i) {    // ---- version to m_famax
+      std::getline(is, line);
+    }
+    int nfiles(-1);
+    is >> nfiles;
+    std::getline(is, line);
+    for(int i(0); i < nfiles; ++i) {
+      std::getline(is, line);
+    }
+    int ndims(0), nboxes(-1);
+    is >> ndims >> nboxes;
+    std::getline(is, line);
+    if( ! is.good() || nfiles < 0 || nboxes < 0) {
+      amrex::Error("Read of VisMF::Header failed");
+    }
+    return static_cast<std::streamoff>(is.tellg()) + sizeof(TheBinaryHeaderMagic)
+           + Long(nboxes) * 2*AMREX_SPACEDIM * sizeof(int);
+}
+
+}
+
 std::ostream&
 operator<< (std::ostream        &os,
             const VisMF::Header &hd)
 {
+    if(hd.m_vers == VisMF::Header::NoFabHeaderBinary_v1) {
+      //
+      // The data files are numbered in the order they first appear.
+      //
+      Vector<std::string> fileNames;
+      std::map<std::string, Long> fileIndex;
+      for(int i(0); i < hd.m_fod.size(); ++i) {
+        if(fileIndex.emplace(hd.m_fod[i].m_name, fileNames.size()).second) {
+          fileNames.push_back(hd.m_fod[i].m_name);
+        }
+      }
+      WriteBinaryPrefix(os, hd, fileNames);
+
+      const Long recordSize(BinaryRecordSize(hd.m_ncomp));
+      std::vector<char> record(recordSize);
+      for(int i(0); i < hd.m_fod.size(); ++i) {
+        PackBinaryRecord(record.data(), hd, i, fileIndex[hd.m_fod[i].m_name]);
+        os.write(record.data(), recordSize);
+      }
+
+      if( ! hd.m_hash.empty()) {
+        os << TheFabHashTag << ' ' << hd.m_hash.size() << '\n';
+        for(int i(0); i < hd.m_hash.size(); ++i) {
+          os << hd.m_hash[i] << '\n';
+        }
+      }
+
+      if( ! os.good()) {
+          amrex::Error("Write of VisMF::Header failed");
+      }
+      return os;
+    }
+
     //
     // Up the precision for the Reals in m_min and m_max.
     // Force it to be written in scientific notation to match fParallel code.
@@ -317,6 +622,13 @@ operator<< (std::ostream        &os,
       }
     }
 
+    if( ! hd.m_hash.empty()) {
+      os << TheFabHashTag << ' ' << hd.m_hash.size() << '\n';
+      for(int i(0); i < hd.m_hash.size(); ++i) {
+        os << hd.m_hash[i] << '\n';
+      }
+    }
+
     os.flags(oflags);
     os.precision(oldPrec);
 
@@ -360,6 +672,11 @@ operator>> (std::istream  &is,
     }
     BL_ASSERT(hd.m_ngrow.min() >= 0);
 
+    if(hd.m_vers == VisMF::Header::NoFabHeaderBinary_v1) {
+      ReadBinaryHeaderRest(is, hd);
+      return is;
+    }
+
     int ba_ndims = hd.m_ba.readFrom(is);
     for (int i = ba_ndims; i < AMREX_SPACEDIM; ++i) {
         hd.m_ngrow[i] = 0;
@@ -401,6 +718,28 @@ operator>> (std::istream  &is,
       is >> hd.m_writtenRD;
     }
 
+    //
+    // The FAB content hashes are optional and come last.
+    //
+    hd.m_hash.clear();
+    if(is.good()) {
+      is >> std::ws;
+      if(is.good() && is.peek() == TheFabHashTag[0]) {
+        std::string tag;
+        int nhash(0);
+        is >> tag >> nhash;
+        if(tag != TheFabHashTag || nhash != hd.m_ba.size()) {
+          amrex::Error("Bad FAB hashes in VisMF::Header");
+        }
+        hd.m_hash.resize(nhash);
+        for(int i(0); i < nhash; ++i) {
+          is >> hd.m_hash[i];
+        }
+      }
+      if(is.eof() && ! is.fail()) {
+        is.clear();
+      }
+    }
 
     if( ! is.good()) {
         amrex::Error("Read of VisMF::Header failed");
@@ -671,6 +1010,33 @@ VisMF::Header::Header (const FabArray<FArrayBox>& mf,
     bool run_on_device = Gpu::inLaunchRegion()
         && (mf.arena()->isManaged() || mf.arena()->isDevice());
 
+    if(version == NoFabHeaderBinary_v1) {
+      // ---- calculate min max values of the local fabs, which are written
+      // ---- to the header by their owners, and FabArray min max values
+      m_min.resize(m_ba.size());
+      m_max.resize(m_ba.size());
+      m_famin.resize(m_ncomp,  std::numeric_limits<Real>::max());
+      m_famax.resize(m_ncomp, -std::numeric_limits<Real>::max());
+
+      for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const int idx = mfi.index();
+        m_min[idx].resize(m_ncomp);
+        m_max[idx].resize(m_ncomp);
+        for(int i(0); i < m_ncomp; ++i) {
+            auto mm = (run_on_device) ? mf[mfi].minmax<RunOn::Device>(m_ba[idx],i)
+                                      : mf[mfi].minmax<RunOn::Host  >(m_ba[idx],i);
+            m_min[idx][i] = mm.first;
+            m_max[idx][i] = mm.second;
+            m_famin[i] = std::min(m_famin[i], mm.first);
+            m_famax[i] = std::max(m_famax[i], mm.second);
+        }
+      }
+      ParallelAllReduce::Min(m_famin.dataPtr(), m_famin.size(), comm);
+      ParallelAllReduce::Max(m_famax.dataPtr(), m_famax.size(), comm);
+
+      return;
+    }
+
     if(version == NoFabHeaderFAMinMax_v1) {
       // ---- calculate FabArray min max values only
       m_min.clear();
@@ -881,7 +1247,11 @@ VisMF::WriteHeaderDoit (const std::string&mf_name, const VisMF::Header& hdr)
 
     MFHdrFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
 
-    MFHdrFile.open(MFHdrFileName.c_str(), std::ios::out | std::ios::trunc);
+    std::ios::openmode mode(std::ios::out | std::ios::trunc);
+    if(hdr.m_vers == VisMF::Header::NoFabHeaderBinary_v1) {
+        mode |= std::ios::binary;
+    }
+    MFHdrFile.open(MFHdrFileName.c_str(), mode);
 
     if( ! MFHdrFile.good()) {
         amrex::FileOpenFailed(MFHdrFileName);
@@ -924,6 +1294,78 @@ VisMF::WriteHeader (const std::string &mf_name, VisMF::Header &hdr,
     return bytesWritten;
 }
 
+Long
+VisMF::WriteBinaryHeaderPrefix (const std::string &mf_name, const VisMF::Header &hdr)
+{
+    std::string MFHdrFileName(mf_name + TheMultiFabHdrFileSuffix);
+
+    VisMF::IO_Buffer io_buffer(ioBufferSize);
+
+    std::ofstream MFHdrFile;
+
+    MFHdrFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+
+    MFHdrFile.open(MFHdrFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+
+    if( ! MFHdrFile.good()) {
+        amrex::FileOpenFailed(MFHdrFileName);
+    }
+
+    WriteBinaryPrefix(MFHdrFile, hdr, hdr.m_fabFileNames);
+
+    Long bytesWritten = VisMF::FileOffset(MFHdrFile);
+
+    MFHdrFile.flush();
+    MFHdrFile.close();
+
+    return bytesWritten;
+}
+
+Long
+VisMF::WriteBinaryHeaderRecords (const std::string &mf_name, const VisMF::Header &hdr,
+                                 const Vector<int> &fabs, Long fileIndex)
+{
+    if(fabs.empty()) {
+        return 0;
+    }
+
+    BL_ASSERT(hdr.m_recordsOffset >= 0);
+    BL_ASSERT(std::is_sorted(fabs.begin(), fabs.end()));
+
+    std::string MFHdrFileName(mf_name + TheMultiFabHdrFileSuffix);
+
+    std::fstream MFHdrFile(MFHdrFileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+
+    if( ! MFHdrFile.good()) {
+        amrex::FileOpenFailed(MFHdrFileName);
+    }
+
+    //
+    // Write the records of consecutive fabs at once.
+    //
+    const Long recordSize(BinaryRecordSize(hdr.m_ncomp));
+    std::vector<char> records;
+    for(int i(0), N(fabs.size()); i < N; ) {
+        int n(1);
+        while(i + n < N && fabs[i+n] == fabs[i] + n) {
+            ++n;
+        }
+        records.resize(n * recordSize);
+        for(int k(0); k < n; ++k) {
+            PackBinaryRecord(records.data() + k*recordSize, hdr, fabs[i+k], fileIndex);
+        }
+        MFHdrFile.seekp(hdr.m_recordsOffset + fabs[i]*recordSize, std::ios::beg);
+        MFHdrFile.write(records.data(), n*recordSize);
+        i += n;
+    }
+
+    if( ! MFHdrFile.good()) {
+        amrex::Error("Write of VisMF::Header records failed:  " + MFHdrFileName);
+    }
+
+    return fabs.size() * recordSize;
+}
+
 
 Long
 VisMF::Write (const FabArray<FArrayBox>&    mf,
@@ -1006,6 +1448,34 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     } else if(useDynamicSetSelection) {
         nfi.SetDynamic();
     }
+
+    // ---- with a binary header, the IOProcessor writes the header without the
+    // ---- records of the fabs, which are written by each process after its data
+    bool binaryHeader(currentVersion == VisMF::Header::NoFabHeaderBinary_v1);
+    Vector<int> headerFileNumbers;  // ---- the data file numbers of hdr.m_fabFileNames
+    Vector<int> localFabs;
+    if(binaryHeader) {
+        if(useSparseFPP) {
+            headerFileNumbers = procsWithDataVector;
+        } else {
+            headerFileNumbers.resize(NFilesIter::ActualNFiles(nOutFiles));
+            std::iota(headerFileNumbers.begin(), headerFileNumbers.end(), 0);
+        }
+        for(int fileNumber : headerFileNumbers) {
+            hdr.m_fabFileNames.push_back(VisMF::BaseName(NFilesIter::FileName(fileNumber, filePrefix)));
+        }
+        if(ParallelDescriptor::IOProcessor()) {
+            hdr.m_recordsOffset = VisMF::WriteBinaryHeaderPrefix(mf_name, hdr);
+            bytesWritten += hdr.m_recordsOffset;
+        }
+        ParallelDescriptor::Bcast(&hdr.m_recordsOffset, 1, ParallelDescriptor::IOProcessorNumber());
+
+        for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            localFabs.push_back(mfi.index());
+        }
+        std::sort(localFabs.begin(), localFabs.end());
+    }
+
     for( ; nfi.ReadyToWrite(); ++nfi) {
         // ---- find the total number of bytes including fab headers if needed
         const FABio &fio = FArrayBox::getFABio();
@@ -1034,12 +1504,16 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 
         if(canCombineFABs) {
             Long writePosition(0);
+            Long fileStart(binaryHeader ? VisMF::FileOffset(nfi.Stream()) : 0);
             for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
                 int hLength(0);
                 const FArrayBox &fab = mf[mfi];
                 writeDataItems = fab.box().numPts() * mf.nComp();
                 writeDataSize = writeDataItems * whichRDBytes;
                 char *afPtr = allFabData + writePosition;
+                if(binaryHeader) {
+                    hdr.m_fod[mfi.index()].m_head = fileStart + writePosition;
+                }
                 if(oldHeader) {
                     std::stringstream hss;
                     fio.write_header(hss, fab, fab.nComp());
@@ -1066,6 +1540,9 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
                 const FArrayBox &fab = mf[mfi];
                 writeDataItems = fab.box().numPts() * mf.nComp();
                 writeDataSize = writeDataItems * whichRDBytes;
+                if(binaryHeader) {
+                    hdr.m_fod[mfi.index()].m_head = VisMF::FileOffset(nfi.Stream());
+                }
                 if(oldHeader) {
                     std::stringstream hss;
                     fio.write_header(hss, fab, fab.nComp());
@@ -1088,6 +1565,16 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
                 }
             }
         }
+
+        if(binaryHeader) {
+            // ---- this process still has its turn for the data file, so the header
+            // ---- is written by at most as many processes as there are data files
+            auto it = std::find(headerFileNumbers.begin(), headerFileNumbers.end(),
+                                nfi.FileNumber());
+            BL_ASSERT(it != headerFileNumbers.end() || localFabs.empty());
+            bytesWritten += VisMF::WriteBinaryHeaderRecords(mf_name, hdr, localFabs,
+                                                            it - headerFileNumbers.begin());
+        }
     }
 
     if(nfi.GetDynamic()) {
@@ -1098,6 +1585,14 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         amrex::prefetchToDevice(mf);  // CalculateMinMax might do work on device
     }
 
+    if(binaryHeader) {
+        delete whichRD;
+        // ---- the records are written by their owners, so the header is
+        // ---- complete only when all of them are done
+        ParallelDescriptor::Barrier("VisMF::Write");
+        return bytesWritten;
+    }
+
     if(currentVersion == VisMF::Header::Version_v1 ||
        currentVersion == VisMF::Header::NoFabHeaderMinMax_v1)
     {
@@ -1149,6 +1644,227 @@ VisMF::WriteOnlyHeader (const FabArray<FArrayBox> & mf,
 }
 
 
+namespace {
+
+//
+// Lexically normalize a path by resolving "." and "dir/.." components.
+//
+std::string
+NormalizePath (const std::string& path)
+{
+    std::vector<std::string> parts;
+    std::string::size_type b = 0;
+    while (b <= path.size()) {
+        auto e = path.find('/', b);
+        if (e == std::string::npos) { e = path.size(); }
+        const std::string part = path.substr(b, e-b);
+        if (part == "..") {
+            if ( ! parts.empty() && parts.back() != "..") {
+                parts.pop_back();
+            } else {
+                parts.push_back(part);
+            }
+        } else if ( ! part.empty() && part != ".") {
+            parts.push_back(part);
+        }
+        b = e+1;
+    }
+    std::string r = ( ! path.empty() && path[0] == '/') ? "/" : "";
+    for (int i = 0; i < static_cast<int>(parts.size()); ++i) {
+        if (i > 0) { r += '/'; }
+        r += parts[i];
+    }
+    return r;
+}
+
+//
+// The path of directory to relative to directory from, with a trailing
+// slash unless empty.  Both have to be absolute or relative to the same
+// directory.  Returns false if that cannot be worked out lexically.
+//
+bool
+RelativeDirectory (const std::string& from, const std::string& to, std::string& rel)
+{
+    const std::string f = NormalizePath(from);
+    const std::string t = NormalizePath(to);
+    const bool fabs = ! f.empty() && f[0] == '/';
+    const bool tabs = ! t.empty() && t[0] == '/';
+    if (fabs != tabs) { return false; }
+
+    auto split = [] (const std::string& p) {
+        std::vector<std::string> parts;
+        std::istringstream iss(p);
+        std::string part;
+        while (std::getline(iss, part, '/')) {
+            if ( ! part.empty()) { parts.push_back(part); }
+        }
+        return parts;
+    };
+    const auto fp = split(f);
+    const auto tp = split(t);
+
+    std::size_t n = 0;
+    while (n < fp.size() && n < tp.size() && fp[n] == tp[n]) { ++n; }
+    rel.clear();
+    for (std::size_t i = n; i < fp.size(); ++i) {
+        if (fp[i] == "..") { return false; }  // ---- would need the cwd
+        rel += "../";
+    }
+    for (std::size_t i = n; i < tp.size(); ++i) {
+        rel += tp[i] + "/";
+    }
+    return true;
+}
+
+}
+
+ULong
+VisMF::FabHash (const FArrayBox& fab)
+{
+    // ---- FNV-1a on 64 bit words, with the high bits folded back after
+    // ---- each multiplication so that they also reach the low bits
+    const auto* p = reinterpret_cast<const unsigned char*>(fab.dataPtr());
+    const std::size_t nbytes = fab.nBytes();
+    const std::size_t nwords = nbytes / sizeof(std::uint64_t);
+    std::uint64_t h = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < nwords; ++i) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i*sizeof(std::uint64_t), sizeof(std::uint64_t));
+        h ^= w;
+        h *= 1099511628211ULL;
+        h ^= h >> 32;
+    }
+    for (std::size_t i = nwords*sizeof(std::uint64_t); i < nbytes; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return static_cast<ULong>(h);
+}
+
+Long
+VisMF::WriteDelta (const FabArray<FArrayBox>& mf,
+                   const std::string& mf_name,
+                   const std::string& prev_name,
+                   VisMF::How how)
+{
+    BL_PROFILE("VisMF::WriteDelta()");
+    BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
+
+    const int nfabs = mf.size();
+    const int ioProc = ParallelDescriptor::IOProcessorNumber();
+
+    amrex::prefetchToHost(mf);
+
+    Vector<ULong> hash(nfabs, 0);
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+#ifdef AMREX_USE_GPU
+        if(mf.arena()->isDevice()) {
+            FArrayBox hfab(mf[mfi].box(), mf.nComp(), The_Pinned_Arena());
+            Gpu::dtoh_memcpy(hfab.dataPtr(), mf[mfi].dataPtr(), hfab.nBytes());
+            hash[mfi.index()] = FabHash(hfab);
+            continue;
+        }
+#endif
+        hash[mfi.index()] = FabHash(mf[mfi]);
+    }
+    ParallelAllReduce::Sum(hash.dataPtr(), nfabs, ParallelDescriptor::Communicator());
+
+    //
+    // Data of the previous FabArray can be referred to if it was written
+    // the same way with the same layout.
+    //
+    VisMF::Header prev_hdr;
+    std::string prev_rel;
+    bool can_refer(false);
+    if( ! prev_name.empty() && VisMF::Exist(prev_name)) {
+        Vector<char> faHeader;
+        ReadFAHeader(prev_name, faHeader);
+        std::istringstream iss(std::string(faHeader.dataPtr(), faHeader.size() - 1),
+                               std::istringstream::in);
+        iss >> prev_hdr;
+
+        bool same_format = FArrayBox::getFormat() == FABio::FAB_NATIVE;
+        if(same_format && ! (prev_hdr.m_vers == VisMF::Header::Version_v1)) {
+            same_format = prev_hdr.m_writtenRD == FPC::NativeRealDescriptor();
+        }
+        can_refer = same_format
+            && prev_hdr.m_vers  == currentVersion
+            && prev_hdr.m_ncomp == mf.nComp()
+            && prev_hdr.m_ngrow == mf.nGrowVect()
+            && prev_hdr.m_hash.size() == nfabs
+            && prev_hdr.m_ba == mf.boxArray()
+            && RelativeDirectory(DirName(mf_name), DirName(prev_name), prev_rel);
+    }
+
+    Vector<char> unchanged(nfabs, 0);
+    if(can_refer) {
+        for(int k(0); k < nfabs; ++k) {
+            unchanged[k] = (hash[k] == prev_hdr.m_hash[k]);
+        }
+    }
+
+    //
+    // Write the FABs that have changed as a FabArray of their own.
+    //
+    Long bytesWritten(0);
+    Vector<int> changed;
+    BoxList bl(mf.boxArray().ixType());
+    Vector<int> pmap;
+    for(int k(0); k < nfabs; ++k) {
+        if( ! unchanged[k]) {
+            changed.push_back(k);
+            bl.push_back(mf.box(k));
+            pmap.push_back(mf.DistributionMap()[k]);
+        }
+    }
+
+    VisMF::Header changed_hdr;
+    if( ! changed.empty()) {
+        BoxArray cba(std::move(bl));
+        DistributionMapping cdm(std::move(pmap));
+        FabArray<FArrayBox> cmf(cba, cdm, mf.nComp(), mf.nGrowVect(), MFInfo().SetAlloc(false));
+        for(MFIter mfi(cmf); mfi.isValid(); ++mfi) {
+            cmf.setFab(mfi, new FArrayBox(mf[changed[mfi.index()]], amrex::make_alias, 0, mf.nComp()));
+        }
+        bytesWritten += VisMF::Write(cmf, mf_name, how);
+        ParallelDescriptor::Barrier("VisMF::WriteDelta");
+        if(ParallelDescriptor::IOProcessor()) {
+            std::ifstream ifs(mf_name + TheMultiFabHdrFileSuffix);
+            ifs >> changed_hdr;
+        }
+    }
+
+    VisMF::Header hdr(mf, how, currentVersion, false);
+    if(currentVersion == VisMF::Header::Version_v1 ||
+       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       currentVersion == VisMF::Header::NoFabHeaderBinary_v1)
+    {
+        hdr.CalculateMinMax(mf, ioProc);
+    }
+
+    if(ParallelDescriptor::IOProcessor()) {
+        for(int k(0), j(0); k < nfabs; ++k) {
+            if(unchanged[k]) {
+                hdr.m_fod[k] = prev_hdr.m_fod[k];
+                hdr.m_fod[k].m_name = NormalizePath(prev_rel + prev_hdr.m_fod[k].m_name);
+            } else {
+                hdr.m_fod[k] = changed_hdr.m_fod[j++];
+            }
+        }
+        hdr.m_hash = hash;
+        bytesWritten += VisMF::WriteHeaderDoit(mf_name, hdr);
+
+        if(verbose) {
+            amrex::Print() << "VisMF::WriteDelta:  " << mf_name << ":  "
+                           << nfabs - changed.size() << " of " << nfabs
+                           << " FABs refer to " << prev_name << '\n';
+        }
+    }
+
+    return bytesWritten;
+}
+
+
 void
 VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
                     const std::string &filePrefix,
@@ -1351,16 +2067,12 @@ VisMF::VisMF (const std::string &fafab_name)
     :
     m_fafabname(fafab_name)
 {
-    std::string FullHdrFileName(m_fafabname);
-
-    FullHdrFileName += TheMultiFabHdrFileSuffix;
-
-    Vector<char> fileCharPtr;
-    ParallelDescriptor::ReadAndBcastFile(FullHdrFileName, fileCharPtr);
-    std::string fileCharPtrString(fileCharPtr.dataPtr());
-    std::istringstream infs(fileCharPtrString, std::istringstream::in);
-
-    infs >> m_hdr;
+    VisMF::ReadHeader(m_fafabname, m_hdr);
+    if(m_hdr.m_vers == Header::NoFabHeaderBinary_v1) {
+        Vector<int> fabs(m_hdr.m_ba.size());
+        std::iota(fabs.begin(), fabs.end(), 0);
+        VisMF::ReadFabRecords(m_fafabname, m_hdr, fabs);
+    }
 
     m_pa.resize(m_hdr.m_ncomp);
 
@@ -1485,24 +2197,9 @@ VisMF::Read (FabArray<FArrayBox> &mf,
         amrex::AllPrint() << myProc << "::VisMF::Read:  about to read:  " << mf_name << std::endl;
     }
 
-    std::string FullHdrFileName(mf_name + TheMultiFabHdrFileSuffix);
-
-    {
-        hStartTime = amrex::second();
-        std::string fileCharPtrString;
-        if(faHeader == nullptr) {
-          Vector<char> fileCharPtr;
-          ParallelDescriptor::ReadAndBcastFile(FullHdrFileName, fileCharPtr);
-          fileCharPtrString = fileCharPtr.dataPtr();
-        } else {
-          fileCharPtrString = faHeader;
-        }
-        std::istringstream infs(fileCharPtrString, std::istringstream::in);
-
-        infs >> hdr;
-
-        hEndTime = amrex::second();
-    }
+    hStartTime = amrex::second();
+    VisMF::ReadHeader(mf_name, hdr, faHeader);
+    hEndTime = amrex::second();
 
     // This allows us to read in an empty MultiFab without an error -- but only if explicitly told to
     if (allow_empty_mf > 0)
@@ -1524,6 +2221,23 @@ VisMF::Read (FabArray<FArrayBox> &mf,
         BL_ASSERT(amrex::match(hdr.m_ba,mf.boxArray()));
     }
 
+    if(hdr.m_vers == VisMF::Header::NoFabHeaderBinary_v1) {
+        // ---- the coordinator schedules the reads of all fabs, and the
+        // ---- aggregated and synchronous reads are in file order
+        Vector<int> fabs;
+        bool allFabs(ParallelDescriptor::MyProc() == coordinatorProc
+                     || useAggregatedReads || useSynchronousReads);
+#ifndef BL_USE_MPI
+        allFabs = false;
+#endif
+        for(int i(0); i < hdr.m_ba.size(); ++i) {
+            if(allFabs || mf.DistributionMap()[i] == ParallelDescriptor::MyProc()) {
+                fabs.push_back(i);
+            }
+        }
+        VisMF::ReadFabRecords(mf_name, hdr, fabs);
+    }
+
 #ifdef BL_USE_MPI
 
   // ---- This limits the number of concurrent readers per file.
@@ -1531,7 +2245,11 @@ VisMF::Read (FabArray<FArrayBox> &mf,
   int nProcs(ParallelDescriptor::NProcs());
   bool noFabHeader(NoFabHeader(hdr));
 
-  if(noFabHeader && useSynchronousReads) {
+  if(useAggregatedReads) {
+
+    VisMF::ReadAggregated(mf, mf_name, hdr);
+
+  } else if(noFabHeader && useSynchronousReads) {
 
     // ---- This code is only for reading in file order
     bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
@@ -1903,6 +2621,9 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 
     if(VisMF::GetUsePersistentIFStreams()) {
       for(int idx(0); idx < hdr.m_fod.size(); ++idx) {
+        if(hdr.m_fod[idx].m_name.empty()) {
+          continue;  // ---- a record that was not read
+        }
         std::string FullName(VisMF::DirName(mf_name));
         FullName += hdr.m_fod[idx].m_name;
         VisMF::DeleteStream(FullName);
@@ -1926,6 +2647,194 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 }
 
 
+namespace {
+
+//
+// An istream buffer over data already read into memory.
+//
+struct MemoryStreamBuf
+    : std::streambuf
+{
+    MemoryStreamBuf (char* b, char* e) { setg(b, b, e); }
+};
+
+}
+
+void
+VisMF::ReadAggregated (FabArray<FArrayBox>& mf,
+                       const std::string& mf_name,
+                       const VisMF::Header& hdr)
+{
+    BL_PROFILE("VisMF::ReadAggregated()");
+
+    const int nProcs(ParallelDescriptor::NProcs());
+    const int myProc(ParallelDescriptor::MyProc());
+    const bool noFabHeader(NoFabHeader(hdr));
+    const int nBoxes(hdr.m_ba.size());
+
+    // ---- the FABs of each file in file order
+    std::map<std::string, Vector<int> > fileFabs;
+    for(int i(0); i < nBoxes; ++i) {
+        fileFabs[hdr.m_fod[i].m_name].push_back(i);
+    }
+
+    // ---- bytes used for balancing the aggregators; fab headers are ignored
+    const Long bytesPerValue = noFabHeader ? hdr.m_writtenRD.numBytes() : sizeof(Real);
+    auto fabBytes = [&] (int i) -> Long {
+        return amrex::grow(hdr.m_ba[i], hdr.m_ngrow).numPts() * hdr.m_ncomp * bytesPerValue;
+    };
+    Long totalBytes(0);
+    for(int i(0); i < nBoxes; ++i) {
+        totalBytes += fabBytes(i);
+    }
+
+    //
+    // Each file gets aggregators in proportion to its size, and each of
+    // them reads a contiguous range of about the same number of bytes.
+    //
+    struct ReadRange {
+        std::string fileName;
+        Vector<int> fabs;     // ---- in file order
+        Long endOffset;       // ---- -1 for the end of the file
+    };
+    Vector<ReadRange> ranges;
+
+    const int nAgg(nAggregators > 0 ? std::min(nAggregators, nProcs) : nProcs);
+    for(auto& ff : fileFabs) {
+        Vector<int>& fabs = ff.second;
+        std::sort(fabs.begin(), fabs.end(), [&hdr] (int a, int b)
+                  { return hdr.m_fod[a].m_head < hdr.m_fod[b].m_head; } );
+        Long fileBytes(0);
+        for(int i : fabs) {
+            fileBytes += fabBytes(i);
+        }
+        int nr = static_cast<int>(static_cast<double>(nAgg) * fileBytes / std::max(totalBytes, Long(1)));
+        nr = std::max(1, std::min(nr, static_cast<int>(fabs.size())));
+
+        const int r0 = ranges.size();
+        ranges.resize(r0 + nr);
+        Long cumBytes(0);
+        for(int i : fabs) {
+            int r = static_cast<int>(static_cast<double>(nr) * cumBytes / std::max(fileBytes, Long(1)));
+            r = std::min(r, nr-1);
+            ranges[r0+r].fabs.push_back(i);
+            cumBytes += fabBytes(i);
+        }
+        // ---- drop empty ranges and find where each one ends
+        ranges.erase(std::remove_if(ranges.begin()+r0, ranges.end(),
+                                    [] (const ReadRange& rr) { return rr.fabs.empty(); }),
+                     ranges.end());
+        for(int r(r0); r < ranges.size(); ++r) {
+            ranges[r].fileName = ff.first;
+            ranges[r].endOffset = (r+1 < ranges.size())
+                ? hdr.m_fod[ranges[r+1].fabs[0]].m_head : Long(-1);
+        }
+    }
+
+    // ---- spread the aggregators over the ranks
+    const int nRanges(ranges.size());
+    Vector<int> rangeRank(nRanges);
+    Vector<int> pmap(nBoxes);
+    for(int r(0); r < nRanges; ++r) {
+        rangeRank[r] = static_cast<int>((static_cast<Long>(r) * nProcs) / nRanges) % nProcs;
+        for(int i : ranges[r].fabs) {
+            pmap[i] = rangeRank[r];
+        }
+    }
+
+    MFInfo info;
+#ifdef AMREX_USE_GPU
+    info.SetArena(The_Pinned_Arena());
+#endif
+    FabArray<FArrayBox> fafabRead(mf.boxArray(), DistributionMapping(std::move(pmap)),
+                                  hdr.m_ncomp, hdr.m_ngrow, info);
+
+    const bool doConvert(noFabHeader && hdr.m_writtenRD != FPC::NativeRealDescriptor());
+
+    for(int r(0); r < nRanges; ++r) {
+        if(rangeRank[r] != myProc) {
+            continue;
+        }
+        const ReadRange& rr = ranges[r];
+        const std::string fullFileName(VisMF::DirName(mf_name) + rr.fileName);
+
+        std::ifstream ifs(fullFileName.c_str(), std::ios::in | std::ios::binary);
+        if( ! ifs.good()) {
+            amrex::FileOpenFailed(fullFileName);
+        }
+        Long endOffset(rr.endOffset);
+        if(endOffset < 0) {
+            ifs.seekg(0, std::ios::end);
+            endOffset = static_cast<std::streamoff>(ifs.tellg());
+        }
+
+        // ---- split the range at FAB boundaries into reads of about aggregatedReadSize
+        Vector<int> readStart(1, 0);   // ---- index into rr.fabs
+        {
+            Long readBytes(0);
+            for(int k(0); k < rr.fabs.size(); ++k) {
+                const Long next = (k+1 < rr.fabs.size()) ? hdr.m_fod[rr.fabs[k+1]].m_head : endOffset;
+                readBytes += next - hdr.m_fod[rr.fabs[k]].m_head;
+                if(readBytes >= aggregatedReadSize && k+1 < rr.fabs.size()) {
+                    readStart.push_back(k+1);
+                    readBytes = 0;
+                }
+            }
+            readStart.push_back(rr.fabs.size());
+        }
+        const int nReads(readStart.size() - 1);
+        auto readOffset = [&] (int k) -> Long {
+            return (k < rr.fabs.size()) ? hdr.m_fod[rr.fabs[k]].m_head : endOffset;
+        };
+
+        auto readData = [&ifs] (Long offset, Long nbytes, Vector<char>* buf) -> bool {
+            buf->resize(nbytes);
+            ifs.seekg(offset, std::ios::beg);
+            ifs.read(buf->dataPtr(), nbytes);
+            return ifs.good();
+        };
+
+        Vector<char> buffers[2];
+        std::future<bool> nextRead = std::async(std::launch::async, readData,
+                                                readOffset(readStart[0]),
+                                                readOffset(readStart[1]) - readOffset(readStart[0]),
+                                                &buffers[0]);
+        for(int ir(0); ir < nReads; ++ir) {
+            if( ! nextRead.get()) {
+                amrex::Error("VisMF::ReadAggregated: failed to read " + fullFileName);
+            }
+            if(ir+1 < nReads) {
+                nextRead = std::async(std::launch::async, readData,
+                                      readOffset(readStart[ir+1]),
+                                      readOffset(readStart[ir+2]) - readOffset(readStart[ir+1]),
+                                      &buffers[(ir+1)%2]);
+            }
+
+            char* data = buffers[ir%2].dataPtr();
+            const Long dataOffset = readOffset(readStart[ir]);
+            for(int k(readStart[ir]); k < readStart[ir+1]; ++k) {
+                FArrayBox& fab = fafabRead[rr.fabs[k]];
+                char* fabData = data + (readOffset(k) - dataOffset);
+                if(noFabHeader) {
+                    if(doConvert) {
+                        RealDescriptor::convertToNativeFormat(fab.dataPtr(), fab.box().numPts()*fab.nComp(),
+                                                              fabData, hdr.m_writtenRD);
+                    } else {
+                        std::memcpy(fab.dataPtr(), fabData, fab.nBytes());
+                    }
+                } else {
+                    MemoryStreamBuf sb(fabData, data + (readOffset(k+1) - dataOffset));
+                    std::istream is(&sb);
+                    fab.readFrom(is);
+                }
+            }
+        }
+    }
+
+    mf.Redistribute(fafabRead, 0, 0, hdr.m_ncomp, amrex::min(hdr.m_ngrow, mf.nGrowVect()));
+}
+
+
 bool
 VisMF::Exist (const std::string& mf_name)
 {
@@ -1951,6 +2860,105 @@ VisMF::ReadFAHeader (const std::string &fafabName,
 }
 
 
+void
+VisMF::ReadHeader (const std::string &fafabName,
+                   VisMF::Header &hdr,
+                   const char *faHeader)
+{
+    if(faHeader != nullptr) {
+        int vers(VisMF::Header::Undefined_v1);
+        {
+            std::istringstream iss(faHeader);
+            iss >> vers;
+        }
+        if(vers != VisMF::Header::NoFabHeaderBinary_v1) {
+            std::istringstream infs(faHeader, std::istringstream::in);
+            infs >> hdr;
+            return;
+        }
+    }
+
+    //
+    // Only the part of a binary header before the records is broadcast.
+    //
+    std::string FullHdrFileName(fafabName + TheMultiFabHdrFileSuffix);
+    const int ioProc(ParallelDescriptor::IOProcessorNumber());
+    Long fileLength(0);
+    Vector<char> fileChars;
+    if(ParallelDescriptor::IOProcessor()) {
+        std::ifstream ifs(FullHdrFileName.c_str(), std::ios::in | std::ios::binary);
+        if( ! ifs.good()) {
+            amrex::FileOpenFailed(FullHdrFileName);
+        }
+        int vers(VisMF::Header::Undefined_v1);
+        ifs >> vers;
+        ifs.seekg(0, std::ios::beg);
+        if(vers == VisMF::Header::NoFabHeaderBinary_v1) {
+            fileLength = BinaryHeaderPrefixLength(ifs);
+        } else {
+            ifs.seekg(0, std::ios::end);
+            fileLength = static_cast<std::streamoff>(ifs.tellg());
+        }
+        ifs.clear();
+        ifs.seekg(0, std::ios::beg);
+        fileChars.resize(fileLength);
+        ifs.read(fileChars.dataPtr(), fileLength);
+        if( ! ifs.good()) {
+            amrex::Error("VisMF::ReadHeader:  read of " + FullHdrFileName + " failed");
+        }
+    }
+    ParallelDescriptor::Bcast(&fileLength, 1, ioProc);
+    fileChars.resize(fileLength);
+    ParallelDescriptor::Bcast(fileChars.dataPtr(), fileLength, ioProc);
+
+    std::istringstream infs(std::string(fileChars.dataPtr(), fileLength), std::istringstream::in);
+    infs >> hdr;
+}
+
+void
+VisMF::ReadFabRecords (const std::string &fafabName,
+                       VisMF::Header &hdr,
+                       const Vector<int> &fabs)
+{
+    if(hdr.m_vers != VisMF::Header::NoFabHeaderBinary_v1 || fabs.empty()) {
+        return;
+    }
+
+    BL_PROFILE("VisMF::ReadFabRecords()");
+
+    std::string FullHdrFileName(fafabName + TheMultiFabHdrFileSuffix);
+    std::ifstream ifs(FullHdrFileName.c_str(), std::ios::in | std::ios::binary);
+    if( ! ifs.good()) {
+        amrex::FileOpenFailed(FullHdrFileName);
+    }
+
+    Vector<int> sorted(fabs);
+    std::sort(sorted.begin(), sorted.end());
+
+    //
+    // Read the records of consecutive fabs at once.
+    //
+    const Long recordSize(BinaryRecordSize(hdr.m_ncomp));
+    std::vector<char> records;
+    for(int i(0), N(sorted.size()); i < N; ) {
+        int n(1);
+        while(i + n < N && sorted[i+n] == sorted[i] + n) {
+            ++n;
+        }
+        records.resize(n * recordSize);
+        ifs.seekg(hdr.m_recordsOffset + sorted[i]*recordSize, std::ios::beg);
+        ifs.read(records.data(), n*recordSize);
+        if( ! ifs.good()) {
+            amrex::Error("VisMF::ReadFabRecords:  read of " + FullHdrFileName + " failed");
+        }
+        for(int k(0); k < n; ++k) {
+            UnpackBinaryRecord(records.data() + k*recordSize, hdr, sorted[i+k]);
+        }
+        i += n;
+    }
+}
+
+
 bool
 VisMF::Check (const std::string& mf_name)
 {
@@ -2078,7 +3086,8 @@ VisMF::clear ()
 bool VisMF::NoFabHeader(const VisMF::Header &hdr) {
   if(hdr.m_vers == VisMF::Header::NoFabHeader_v1       ||
     hdr.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-    hdr.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+    hdr.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+    hdr.m_vers == VisMF::Header::NoFabHeaderBinary_v1)
   {
     return true;
   }
@@ -2310,6 +3319,12 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
         }
     }
 
+    Long staged_bytes = 0;
+    for (auto const& fab : *myfabs) {
+        staged_bytes += fab.nBytes();
+    }
+    AsyncOut::AddStagedBytes(staged_bytes);
+
     std::shared_ptr<FABio> fabio(new FABio_binary(FPC::NativeRealDescriptor().clone()));
 
     AsyncOut::Submit([=] ()
@@ -2413,6 +3428,8 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
         ofs.close();
 
         AsyncOut::Notify();  // Notify others I am done
+
+        AsyncOut::AddStagedBytes(-staged_bytes);
     });
 }
 
@@ -10,8 +10,13 @@
 #include <AMReX_EB2_GeometryShop.H>
 #include <AMReX_EB2.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
 #include <AMReX.H>
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -63,6 +68,214 @@ IndexSpace::erase (IndexSpace* ispace)
     }
 }
 
+namespace {
+    const std::string index_space_version("EB2::IndexSpace-V2");
+
+    std::string levelDir (const std::string& dir, int ilev)
+    {
+        return dir + "/Level_" + std::to_string(ilev);
+    }
+
+    void writeGeometry (std::ostream& os, const Geometry& geom)
+    {
+        os << std::setprecision(17) << geom.Coord();
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            os << " " << geom.ProbLo(idim) << " " << geom.ProbHi(idim)
+               << " " << geom.isPeriodic(idim);
+        }
+        os << " " << geom.Domain();
+    }
+
+    // FNV-1a hash of the eb2.* inputs, which define the geometry built
+    // by EB2::Build(geom,...).
+    std::string inputsHash ()
+    {
+        std::ostringstream table;
+        ParmParse::dumpTable(table, false);
+        std::istringstream iss(table.str());
+        std::uint64_t h = 14695981039346656037ULL;
+        std::string line;
+        while (std::getline(iss, line)) {
+            if (line.compare(0, 4, "eb2.") == 0 &&
+                line.compare(0, 20, "eb2.index_space_file") != 0)
+            {
+                for (unsigned char c : line) {
+                    h = (h ^ c) * 1099511628211ULL;
+                }
+            }
+        }
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << h;
+        return os.str();
+    }
+}
+
+std::string
+BuildParameters (int required_coarsening_level, int max_coarsening_level,
+                 int ngrow, bool build_coarse_level_by_coarsening,
+                 bool a_extend_domain_face)
+{
+    Real small_volfrac = 1.e-14;
+    bool cover_multiple_cuts = false;
+    ParmParse pp("eb2");
+    pp.query("small_volfrac", small_volfrac);
+    pp.query("cover_multiple_cuts", cover_multiple_cuts);
+
+    std::ostringstream os;
+    os << std::setprecision(17) << required_coarsening_level << " "
+       << max_coarsening_level << " " << ngrow << " "
+       << build_coarse_level_by_coarsening << " " << a_extend_domain_face << " "
+       << EB2::max_grid_size << " " << small_volfrac << " " << cover_multiple_cuts;
+    return os.str();
+}
+
+void
+IndexSpace::writeLevels (const std::string& dir, const std::string& geom_hash,
+                         const std::string& build_params,
+                         const Vector<Level const*>& levels,
+                         const Vector<Geometry>& geom, const Vector<int>& ngrow)
+{
+    BL_PROFILE("EB2::IndexSpace::write()");
+
+    const int nlevels = levels.size();
+    if (ParallelDescriptor::IOProcessor())
+    {
+        amrex::UtilCreateCleanDirectory(dir, false);
+        for (int ilev = 0; ilev < nlevels; ++ilev) {
+            if (!amrex::UtilCreateDirectory(levelDir(dir,ilev), 0755)) {
+                amrex::CreateDirectoryFailed(levelDir(dir,ilev));
+            }
+        }
+
+        std::ofstream ofs(dir + "/Header");
+        ofs << index_space_version << "\n"
+            << geom_hash << "\n"
+            << build_params << "\n";
+        writeGeometry(ofs, geom[0]);
+        ofs << "\n" << nlevels;
+        for (int ilev = 0; ilev < nlevels; ++ilev) {
+            ofs << " " << ngrow[ilev];
+        }
+        ofs << "\n";
+        if ( ! ofs.good()) {
+            amrex::FileOpenFailed(dir + "/Header");
+        }
+    }
+    ParallelDescriptor::Barrier("EB2::IndexSpace::write");
+
+    for (int ilev = 0; ilev < nlevels; ++ilev) {
+        levels[ilev]->write(levelDir(dir,ilev));
+    }
+}
+
+IndexSpaceChkptFile::IndexSpaceChkptFile (const std::string& dir, const Geometry& geom,
+                                          int nlevels, const Vector<int>& ngrow,
+                                          const std::string& build_params)
+    : m_ngrow(ngrow),
+      m_build_params(build_params)
+{
+    m_chkptlevel.reserve(nlevels);
+    for (int ilev = 0; ilev < nlevels; ++ilev) {
+        m_geom.push_back((ilev == 0) ? geom : amrex::coarsen(m_geom.back(),2));
+        m_domain.push_back(m_geom.back().Domain());
+        m_chkptlevel.emplace_back(this, m_geom.back(), levelDir(dir,ilev));
+    }
+}
+
+const Level&
+IndexSpaceChkptFile::getLevel (const Geometry& geom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), geom.Domain());
+    int i = std::distance(m_domain.begin(), it);
+    return m_chkptlevel[i];
+}
+
+const Geometry&
+IndexSpaceChkptFile::getGeometry (const Box& dom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), dom);
+    int i = std::distance(m_domain.begin(), it);
+    return m_geom[i];
+}
+
+void
+IndexSpaceChkptFile::write (const std::string& dir, const std::string& geom_hash) const
+{
+    Vector<Level const*> levels;
+    for (auto const& lev : m_chkptlevel) {
+        levels.push_back(&lev);
+    }
+    writeLevels(dir, geom_hash, m_build_params, levels, m_geom, m_ngrow);
+}
+
+void
+WriteIndexSpace (const std::string& dir, const std::string& geom_hash)
+{
+    IndexSpace::top().write(dir, geom_hash);
+}
+
+bool
+ReadIndexSpace (const std::string& dir, const std::string& geom_hash,
+                const Geometry& geom,
+                int required_coarsening_level, int max_coarsening_level,
+                int ngrow, bool build_coarse_level_by_coarsening,
+                bool a_extend_domain_face)
+{
+    BL_PROFILE("EB2::ReadIndexSpace()");
+
+    int exists = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        exists = amrex::FileExists(dir + "/Header");
+    }
+    ParallelDescriptor::Bcast(&exists, 1, ParallelDescriptor::IOProcessorNumber());
+    if (!exists) return false;
+
+    Vector<char> buf;
+    ParallelDescriptor::ReadAndBcastFile(dir + "/Header", buf);
+    std::istringstream iss(std::string(buf.dataPtr()), std::istringstream::in);
+
+    std::string version, hash, params, geomstr;
+    std::getline(iss, version);
+    std::getline(iss, hash);
+    std::getline(iss, params);
+    std::getline(iss, geomstr);
+
+    std::ostringstream os;
+    writeGeometry(os, geom);
+    const std::string build_params = BuildParameters(required_coarsening_level,
+                                                     max_coarsening_level, ngrow,
+                                                     build_coarse_level_by_coarsening,
+                                                     a_extend_domain_face);
+
+    std::string mismatch;
+    if (version != index_space_version) {
+        mismatch = "version";
+    } else if (hash != geom_hash) {
+        mismatch = "geometry hash";
+    } else if (params != build_params) {
+        mismatch = "build parameters";
+    } else if (geomstr != os.str()) {
+        mismatch = "Geometry";
+    }
+    if (!mismatch.empty()) {
+        if (amrex::Verbose()) {
+            amrex::Print() << "EB2::ReadIndexSpace: " << dir
+                           << " not used because of a " << mismatch << " mismatch\n";
+        }
+        return false;
+    }
+
+    int nlevels;
+    iss >> nlevels;
+    Vector<int> ng(nlevels);
+    for (int ilev = 0; ilev < nlevels; ++ilev) {
+        iss >> ng[ilev];
+    }
+
+    IndexSpace::push(new IndexSpaceChkptFile(dir, geom, nlevels, ng, build_params));
+    return true;
+}
+
 const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     if (IndexSpace::size() > 0) {
         return &IndexSpace::top();
@@ -70,9 +283,10 @@ const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     return nullptr;
 }
 
+namespace {
 void
-Build (const Geometry& geom, int required_coarsening_level,
-       int max_coarsening_level, int ngrow, bool build_coarse_level_by_coarsening)
+BuildFromInputs (const Geometry& geom, int required_coarsening_level,
+                 int max_coarsening_level, int ngrow, bool build_coarse_level_by_coarsening)
 {
     ParmParse pp("eb2");
     std::string geom_type;
@@ -182,6 +396,35 @@ Build (const Geometry& geom, int required_coarsening_level,
         amrex::Abort("geom_type "+geom_type+ " not supported");
     }
 }
+}
+
+void
+Build (const Geometry& geom, int required_coarsening_level,
+       int max_coarsening_level, int ngrow, bool build_coarse_level_by_coarsening)
+{
+    // If eb2.index_space_file is set, the IndexSpace is read from it when
+    // it was built from the same inputs, and written to it otherwise.
+    ParmParse pp("eb2");
+    std::string index_space_file;
+    pp.query("index_space_file", index_space_file);
+
+    std::string geom_hash;
+    if (!index_space_file.empty()) {
+        geom_hash = inputsHash();
+        if (ReadIndexSpace(index_space_file, geom_hash, geom, required_coarsening_level,
+                           max_coarsening_level, ngrow, build_coarse_level_by_coarsening))
+        {
+            return;
+        }
+    }
+
+    BuildFromInputs(geom, required_coarsening_level, max_coarsening_level,
+                    ngrow, build_coarse_level_by_coarsening);
+
+    if (!index_space_file.empty()) {
+        WriteIndexSpace(index_space_file, geom_hash);
+    }
+}
 
 namespace {
 static int comp_max_crse_level (Box cdomain, const Box& domain)
@@ -1,7 +1,10 @@
 
 #include <AMReX_EB2_Level.H>
 #include <AMReX_IArrayBox.H>
+#include <AMReX_VisMF.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -915,4 +918,150 @@ Level::fillLevelSet (MultiFab& levelset, const Geometry& geom) const
     }
 }
 
+// CellData holds the cell flag followed by volfrac, centroid, bndryarea,
+// bndrycent and bndrynorm.  FaceData_<d> holds areafrac and facecent.
+// The 32-bit flag is stored as two 16-bit halves, which are exact also
+// in single precision.
+namespace {
+    constexpr int cd_flag = 0;
+    constexpr int cd_volfrac = 2;
+    constexpr int cd_centroid = cd_volfrac + 1;
+    constexpr int cd_bndryarea = cd_centroid + AMREX_SPACEDIM;
+    constexpr int cd_bndrycent = cd_bndryarea + 1;
+    constexpr int cd_bndrynorm = cd_bndrycent + AMREX_SPACEDIM;
+    constexpr int cd_ncomp = cd_bndrynorm + AMREX_SPACEDIM;
+}
+
+void
+Level::write (const std::string& dir) const
+{
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ofstream ofs(dir + "/Header");
+        // An empty BoxArray cannot be read back, so the sizes go first.
+        ofs << m_allregular << "\n" << m_ngrow << "\n";
+        for (BoxArray const* ba : {&m_grids, &m_covered_grids}) {
+            ofs << ba->size() << "\n";
+            if (!ba->empty()) {
+                ba->writeOn(ofs);
+                ofs << "\n";
+            }
+        }
+        if ( ! ofs.good()) {
+            amrex::FileOpenFailed(dir + "/Header");
+        }
+    }
+
+    if (m_allregular) return;
+
+    const int ng = m_volfrac.nGrow();
+    MultiFab celldata(m_grids, m_dmap, cd_ncomp, ng);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(celldata); mfi.isValid(); ++mfi)
+    {
+        Array4<EBCellFlag const> const& flag = m_cellflag.const_array(mfi);
+        Array4<Real> const& cd = celldata.array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_3D(mfi.fabbox(), i, j, k,
+        {
+            const uint32_t f = flag(i,j,k).getValue();
+            cd(i,j,k,cd_flag  ) = static_cast<Real>(f & 0xFFFFu);
+            cd(i,j,k,cd_flag+1) = static_cast<Real>(f >> 16);
+        });
+    }
+    MultiFab::Copy(celldata, m_volfrac, 0, cd_volfrac, 1, ng);
+    MultiFab::Copy(celldata, m_centroid, 0, cd_centroid, AMREX_SPACEDIM, ng);
+    MultiFab::Copy(celldata, m_bndryarea, 0, cd_bndryarea, 1, ng);
+    MultiFab::Copy(celldata, m_bndrycent, 0, cd_bndrycent, AMREX_SPACEDIM, ng);
+    MultiFab::Copy(celldata, m_bndrynorm, 0, cd_bndrynorm, AMREX_SPACEDIM, ng);
+    VisMF::Write(celldata, dir + "/CellData");
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        MultiFab facedata(m_areafrac[idim].boxArray(), m_dmap, AMREX_SPACEDIM, ng);
+        MultiFab::Copy(facedata, m_areafrac[idim], 0, 0, 1, ng);
+        MultiFab::Copy(facedata, m_facecent[idim], 0, 1, AMREX_SPACEDIM-1, ng);
+        VisMF::Write(facedata, dir + "/FaceData_" + std::to_string(idim));
+        VisMF::Write(m_edgecent[idim], dir + "/EdgeCent_" + std::to_string(idim));
+    }
+
+    MultiFab levelset(m_levelset.boxArray(), m_dmap, 1, 0);
+    MultiFab::Copy(levelset, m_levelset, 0, 0, 1, 0);
+    VisMF::Write(levelset, dir + "/LevelSet");
+}
+
+ChkptFileLevel::ChkptFileLevel (IndexSpace const* is, const Geometry& geom, const std::string& dir)
+    : Level(is, geom)
+{
+    BL_PROFILE("EB2::ChkptFileLevel()");
+
+    {
+        Vector<char> buf;
+        ParallelDescriptor::ReadAndBcastFile(dir + "/Header", buf);
+        std::istringstream iss(std::string(buf.dataPtr()), std::istringstream::in);
+        iss >> m_allregular >> m_ngrow;
+        for (BoxArray* ba : {&m_grids, &m_covered_grids}) {
+            Long n;
+            iss >> n;
+            if (n > 0) {
+                ba->readFrom(iss);
+            }
+        }
+    }
+
+    m_ok = true;
+    if (m_allregular) return;
+
+    MultiFab celldata;
+    VisMF::Read(celldata, dir + "/CellData");
+    AMREX_ALWAYS_ASSERT(celldata.boxArray() == m_grids && celldata.nComp() == cd_ncomp);
+    m_dmap = celldata.DistributionMap();
+    const int ng = celldata.nGrow();
+
+    MFInfo mf_info;
+    mf_info.SetTag("EB2::Level");
+    m_cellflag.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_volfrac.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_centroid.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndryarea.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_bndrycent.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndrynorm.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(celldata); mfi.isValid(); ++mfi)
+    {
+        Array4<EBCellFlag> const& flag = m_cellflag.array(mfi);
+        Array4<Real const> const& cd = celldata.const_array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_3D(mfi.fabbox(), i, j, k,
+        {
+            flag(i,j,k) = EBCellFlag( static_cast<uint32_t>(cd(i,j,k,cd_flag))
+                                    | (static_cast<uint32_t>(cd(i,j,k,cd_flag+1)) << 16));
+        });
+    }
+    MultiFab::Copy(m_volfrac, celldata, cd_volfrac, 0, 1, ng);
+    MultiFab::Copy(m_centroid, celldata, cd_centroid, 0, AMREX_SPACEDIM, ng);
+    MultiFab::Copy(m_bndryarea, celldata, cd_bndryarea, 0, 1, ng);
+    MultiFab::Copy(m_bndrycent, celldata, cd_bndrycent, 0, AMREX_SPACEDIM, ng);
+    MultiFab::Copy(m_bndrynorm, celldata, cd_bndrynorm, 0, AMREX_SPACEDIM, ng);
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const BoxArray& fba = amrex::convert(m_grids, IntVect::TheDimensionVector(idim));
+        MultiFab facedata(fba, m_dmap, AMREX_SPACEDIM, ng);
+        VisMF::Read(facedata, dir + "/FaceData_" + std::to_string(idim));
+        m_areafrac[idim].define(fba, m_dmap, 1, ng, mf_info);
+        m_facecent[idim].define(fba, m_dmap, AMREX_SPACEDIM-1, ng, mf_info);
+        MultiFab::Copy(m_areafrac[idim], facedata, 0, 0, 1, ng);
+        MultiFab::Copy(m_facecent[idim], facedata, 1, 0, AMREX_SPACEDIM-1, ng);
+
+        IntVect edge_type{1}; edge_type[idim] = 0;
+        m_edgecent[idim].define(amrex::convert(m_grids, edge_type), m_dmap, 1, ng, mf_info);
+        VisMF::Read(m_edgecent[idim], dir + "/EdgeCent_" + std::to_string(idim));
+    }
+
+    m_levelset.define(amrex::convert(m_grids,IntVect::TheNodeVector()), m_dmap, 1, 0);
+    VisMF::Read(m_levelset, dir + "/LevelSet");
+}
+
 }}
@@ -0,0 +1,268 @@
+
+#include <AMReX_EBCutCellData.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_Scan.H>
+
+#include <AMReX_EB2_Level.H>
+
+namespace amrex {
+
+namespace {
+
+// Calls f(mf,comp) for each quantity of the packed data, where mf holds
+// the dense data of the quantity and comp is its first packed component.
+template <class F>
+void forEachQuantity (const EB2::Level& level, const Geometry& geom,
+                      const BoxArray& ba, const DistributionMapping& dm,
+                      int ng, EBSupport support, F&& f)
+{
+    {
+        MultiFab centroid(ba, dm, AMREX_SPACEDIM, ng);
+        level.fillCentroid(centroid, geom);
+        f(centroid, EBCutCellArray::centroid_comp);
+    }
+
+    if (support != EBSupport::full) return;
+
+    {
+        MultiFab bndrycent(ba, dm, AMREX_SPACEDIM, ng);
+        level.fillBndryCent(bndrycent, geom);
+        f(bndrycent, EBCutCellArray::bndrycent_comp);
+    }
+    {
+        MultiFab bndryarea(ba, dm, 1, ng);
+        level.fillBndryArea(bndryarea, geom);
+        f(bndryarea, EBCutCellArray::bndryarea_comp);
+    }
+    {
+        MultiFab bndrynorm(ba, dm, AMREX_SPACEDIM, ng);
+        level.fillBndryNorm(bndrynorm, geom);
+        f(bndrynorm, EBCutCellArray::bndrynorm_comp);
+    }
+
+    Array<MultiFab,AMREX_SPACEDIM> areafrac;
+    Array<MultiFab,AMREX_SPACEDIM> facecent;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const BoxArray& faceba = amrex::convert(ba, IntVect::TheDimensionVector(idim));
+        areafrac[idim].define(faceba, dm, 1, ng);
+        facecent[idim].define(faceba, dm, AMREX_SPACEDIM-1, ng);
+    }
+    level.fillAreaFrac(GetArrOfPtrs(areafrac), geom);
+    level.fillFaceCent(GetArrOfPtrs(facecent), geom);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        f(areafrac[idim], EBCutCellArray::areafrac_comp+idim);
+        f(facecent[idim], EBCutCellArray::facecent_comp+idim*(AMREX_SPACEDIM-1));
+        areafrac[idim].clear();
+        facecent[idim].clear();
+    }
+
+    Array<MultiFab,AMREX_SPACEDIM> edgecent;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        IntVect edge_type{1}; edge_type[idim] = 0;
+        edgecent[idim].define(amrex::convert(ba, edge_type), dm, 1, ng);
+    }
+    level.fillEdgeCent(GetArrOfPtrs(edgecent), geom);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        f(edgecent[idim], EBCutCellArray::edgecent_comp+idim);
+    }
+}
+
+}
+
+EBCutCellData::EBCutCellData (const EB2::Level& a_level, const Geometry& a_geom,
+                              const BoxArray& a_ba, const DistributionMapping& a_dm,
+                              int a_ngrow, const FabArray<EBCellFlagFab>& a_cellflags,
+                              EBSupport a_support)
+    : m_cellflags(&a_cellflags),
+      m_ngrow(a_ngrow),
+      m_ncomp((a_support == EBSupport::full) ? EBCutCellArray::ncomp_full
+                                             : EBCutCellArray::ncomp_volume),
+      m_slot(a_ba, a_dm),
+      m_data(a_ba, a_dm)
+{
+    BL_PROFILE("EBCutCellData::EBCutCellData()");
+
+    AMREX_ALWAYS_ASSERT(a_support >= EBSupport::volume && m_ngrow <= a_cellflags.nGrow());
+
+    // The lookup of a box also covers the cells owning its high faces and
+    // edges.  It is first used to mark the cells that need a slot.
+    for (MFIter mfi(m_slot); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            Box bx = amrex::grow(a_ba[mfi.index()], m_ngrow);
+            bx.setBig(bx.bigEnd() + IntVect::TheUnitVector());
+            m_slot[mfi].resize(bx, 1);
+            m_slot[mfi].setVal<RunOn::Device>(0);
+        }
+    }
+
+    const int ncomp = m_ncomp;
+
+    forEachQuantity(a_level, a_geom, a_ba, a_dm, m_ngrow, a_support,
+    [&] (MultiFab const& mf, int comp)
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            if (ok(mfi)) {
+                Array4<Real const> const& v = mf.const_array(mfi);
+                Array4<int> const& mark = m_slot[mfi].array();
+                EBCutCellArray a;
+                a.flag = m_cellflags->const_array(mfi);
+                a.ncomp = ncomp;
+                amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    if (v(i,j,k,n) != a.get(i,j,k,comp+n)) {
+                        mark(i,j,k) = 1;
+                    }
+                });
+            }
+        }
+    });
+
+    for (MFIter mfi(m_slot); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            int* p = m_slot[mfi].dataPtr();
+            const int npts = m_slot[mfi].box().numPts();
+            int nslots = 0;
+#ifdef AMREX_USE_GPU
+            if (Gpu::inLaunchRegion()) {
+                nslots = Scan::PrefixSum<int>(npts,
+                    [=] AMREX_GPU_DEVICE (int i) -> int { return p[i]; },
+                    [=] AMREX_GPU_DEVICE (int i, int const& x) { p[i] = (p[i]) ? x : -1; },
+                    Scan::Type::exclusive);
+            } else
+#endif
+            {
+                for (int i = 0; i < npts; ++i) {
+                    p[i] = (p[i]) ? nslots++ : -1;
+                }
+            }
+
+            m_data[mfi].resize(static_cast<std::size_t>(nslots)*ncomp);
+            Real* d = m_data[mfi].data();
+            amrex::ParallelFor(nslots*ncomp, [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                d[i] = 0.0;
+            });
+        }
+    }
+
+    forEachQuantity(a_level, a_geom, a_ba, a_dm, m_ngrow, a_support,
+    [&] (MultiFab const& mf, int comp)
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            if (ok(mfi)) {
+                Array4<Real const> const& v = mf.const_array(mfi);
+                Array4<int const> const& slot = m_slot[mfi].const_array();
+                Real* d = m_data[mfi].data();
+                amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    const int s = slot(i,j,k);
+                    if (s >= 0) {
+                        d[s*ncomp+comp+n] = v(i,j,k,n);
+                    }
+                });
+            }
+        }
+    });
+}
+
+bool
+EBCutCellData::ok (const MFIter& mfi) const noexcept
+{
+    return (*m_cellflags)[mfi].getType() == FabType::singlevalued;
+}
+
+EBCutCellArray
+EBCutCellData::const_array (const MFIter& mfi) const noexcept
+{
+    AMREX_ASSERT(ok(mfi));
+    EBCutCellArray r;
+    r.slot = m_slot[mfi].const_array();
+    r.flag = m_cellflags->const_array(mfi);
+    r.data = m_data[mfi].data();
+    r.ncomp = m_ncomp;
+    return r;
+}
+
+Long
+EBCutCellData::numSlots () const noexcept
+{
+    Long r = 0;
+    for (MFIter mfi(m_slot); mfi.isValid(); ++mfi) {
+        r += m_data[mfi].size() / m_ncomp;
+    }
+    return r;
+}
+
+Long
+EBCutCellData::nBytes () const noexcept
+{
+    Long r = 0;
+    for (MFIter mfi(m_slot); mfi.isValid(); ++mfi) {
+        r += m_slot[mfi].nBytes() + m_data[mfi].size()*sizeof(Real);
+    }
+    return r;
+}
+
+EBCutCellFab::EBCutCellFab (const EBFArrayBoxFactory& a_factory, const MFIter& mfi,
+                            const Box& bx)
+{
+    if (a_factory.cutCellStorage() == EBCutCellStorage::dense)
+    {
+        m_centroid = a_factory.getCentroid().const_array(mfi);
+        if (a_factory.ebSupport() == EBSupport::full) {
+            m_bndrycent = a_factory.getBndryCent().const_array(mfi);
+            m_bndryarea = a_factory.getBndryArea().const_array(mfi);
+            m_bndrynorm = a_factory.getBndryNormal().const_array(mfi);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_areafrac[idim] = a_factory.getAreaFrac()[idim]->const_array(mfi);
+                m_facecent[idim] = a_factory.getFaceCent()[idim]->const_array(mfi);
+                m_edgecent[idim] = a_factory.getEdgeCent()[idim]->const_array(mfi);
+            }
+        }
+    }
+    else
+    {
+        const EBCutCellData& ccd = a_factory.getCutCellData();
+        Box fbx = bx & amrex::grow(a_factory.boxArray()[mfi.index()], ccd.nGrow());
+        fbx.setBig(fbx.bigEnd() + IntVect::TheUnitVector());
+        const int ncomp = ccd.nComp();
+        m_fab.resize(fbx, ncomp, The_Async_Arena());
+
+        Array4<Real> const& a = m_fab.array();
+        const EBCutCellArray cc = ccd.const_array(mfi);
+        amrex::ParallelFor(fbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = cc.get(i,j,k,n);
+        });
+
+        Array4<Real const> const& ca = m_fab.const_array();
+        m_centroid = Array4<Real const>(ca, EBCutCellArray::centroid_comp, AMREX_SPACEDIM);
+        if (ncomp == EBCutCellArray::ncomp_full) {
+            m_bndrycent = Array4<Real const>(ca, EBCutCellArray::bndrycent_comp, AMREX_SPACEDIM);
+            m_bndryarea = Array4<Real const>(ca, EBCutCellArray::bndryarea_comp, 1);
+            m_bndrynorm = Array4<Real const>(ca, EBCutCellArray::bndrynorm_comp, AMREX_SPACEDIM);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_areafrac[idim] = Array4<Real const>(ca, EBCutCellArray::areafrac_comp+idim, 1);
+                m_facecent[idim] = Array4<Real const>(ca, EBCutCellArray::facecent_comp
+                                                      +idim*(AMREX_SPACEDIM-1), AMREX_SPACEDIM-1);
+                m_edgecent[idim] = Array4<Real const>(ca, EBCutCellArray::edgecent_comp+idim, 1);
+            }
+        }
+    }
+}
+
+}
@@ -2,6 +2,7 @@
 #include <AMReX_EBDataCollection.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_EBCutCellData.H>
 
 #include <AMReX_EB2_Level.H>
 
@@ -11,9 +12,11 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
                                     const Geometry& a_geom,
                                     const BoxArray& a_ba_in,
                                     const DistributionMapping& a_dm,
-                                    const Vector<int>& a_ngrow, EBSupport a_support)
+                                    const Vector<int>& a_ngrow, EBSupport a_support,
+                                    EBCutCellStorage a_storage)
     : m_ngrow(a_ngrow),
       m_support(a_support),
+      m_storage(a_storage),
       m_geom(a_geom)
 {
     // The BoxArray argument may not be cell-centered BoxArray.
@@ -24,13 +27,36 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
         m_cellflags = new FabArray<EBCellFlagFab>(a_ba, a_dm, 1, m_ngrow[0], MFInfo(),
                                                   DefaultFabFactory<EBCellFlagFab>());
         a_level.fillEBCellFlag(*m_cellflags, m_geom);
+
+        if (FabArrayBase::SkipCoveredBoxes)
+        {
+            Vector<int> covered(a_ba.size(), 0);
+            for (MFIter mfi(*m_cellflags); mfi.isValid(); ++mfi) {
+                if ((*m_cellflags)[mfi].getType(mfi.validbox()) == FabType::covered) {
+                    covered[mfi.index()] = 1;
+                }
+            }
+            ParallelDescriptor::ReduceIntMax(covered.data(), covered.size());
+            m_covered_boxes = std::make_shared<const Vector<char> >(covered.begin(), covered.end());
+        }
     }
 
     if (m_support >= EBSupport::volume)
     {
         m_volfrac = new MultiFab(a_ba, a_dm, 1, m_ngrow[1], MFInfo(), FArrayBoxFactory());
         a_level.fillVolFrac(*m_volfrac, m_geom);
+    }
+
+    if (m_support >= EBSupport::volume && m_storage == EBCutCellStorage::sparse)
+    {
+        const int ng = (m_support == EBSupport::full) ? amrex::max(m_ngrow[1],m_ngrow[2])
+                                                      : m_ngrow[1];
+        m_cutcells = new EBCutCellData(a_level, m_geom, a_ba, a_dm, ng, *m_cellflags, m_support);
+        return;
+    }
 
+    if (m_support >= EBSupport::volume)
+    {
         m_centroid = new MultiCutFab(a_ba, a_dm, AMREX_SPACEDIM, m_ngrow[1], *m_cellflags);
         a_level.fillCentroid(*m_centroid, m_geom);
     }
@@ -65,6 +91,7 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
 
 EBDataCollection::~EBDataCollection ()
 {
+    delete m_cutcells;
     delete m_cellflags;
     delete m_volfrac;
     delete m_centroid;
@@ -95,6 +122,10 @@ EBDataCollection::getVolFrac () const
 const MultiCutFab&
 EBDataCollection::getCentroid () const
 {
+    if (m_centroid == nullptr && m_cutcells != nullptr) {
+        m_centroid = makeMultiCutFab(IntVect::TheZeroVector(), AMREX_SPACEDIM, m_ngrow[1],
+                                     EBCutCellArray::centroid_comp);
+    }
     AMREX_ASSERT(m_centroid != nullptr);
     return *m_centroid;
 }
@@ -102,6 +133,10 @@ EBDataCollection::getCentroid () const
 const MultiCutFab&
 EBDataCollection::getBndryCent () const
 {
+    if (m_bndrycent == nullptr && m_cutcells != nullptr && m_support == EBSupport::full) {
+        m_bndrycent = makeMultiCutFab(IntVect::TheZeroVector(), AMREX_SPACEDIM, m_ngrow[2],
+                                      EBCutCellArray::bndrycent_comp);
+    }
     AMREX_ASSERT(m_bndrycent != nullptr);
     return *m_bndrycent;
 }
@@ -109,6 +144,10 @@ EBDataCollection::getBndryCent () const
 const MultiCutFab&
 EBDataCollection::getBndryArea () const
 {
+    if (m_bndryarea == nullptr && m_cutcells != nullptr && m_support == EBSupport::full) {
+        m_bndryarea = makeMultiCutFab(IntVect::TheZeroVector(), 1, m_ngrow[2],
+                                      EBCutCellArray::bndryarea_comp);
+    }
     AMREX_ASSERT(m_bndryarea != nullptr);
     return *m_bndryarea;
 }
@@ -116,6 +155,12 @@ EBDataCollection::getBndryArea () const
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getAreaFrac () const
 {
+    if (m_areafrac[0] == nullptr && m_cutcells != nullptr && m_support == EBSupport::full) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_areafrac[idim] = makeMultiCutFab(IntVect::TheDimensionVector(idim), 1, m_ngrow[2],
+                                               EBCutCellArray::areafrac_comp+idim);
+        }
+    }
     AMREX_ASSERT(m_areafrac[0] != nullptr);
     return {AMREX_D_DECL(m_areafrac[0], m_areafrac[1], m_areafrac[2])};
 }
@@ -123,6 +168,14 @@ EBDataCollection::getAreaFrac () const
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getFaceCent () const
 {
+    if (m_facecent[0] == nullptr && m_cutcells != nullptr && m_support == EBSupport::full) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_facecent[idim] = makeMultiCutFab(IntVect::TheDimensionVector(idim),
+                                               AMREX_SPACEDIM-1, m_ngrow[2],
+                                               EBCutCellArray::facecent_comp
+                                               +idim*(AMREX_SPACEDIM-1));
+        }
+    }
     AMREX_ASSERT(m_facecent[0] != nullptr);
     return {AMREX_D_DECL(m_facecent[0], m_facecent[1], m_facecent[2])};
 }
@@ -130,6 +183,13 @@ EBDataCollection::getFaceCent () const
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getEdgeCent () const
 {
+    if (m_edgecent[0] == nullptr && m_cutcells != nullptr && m_support == EBSupport::full) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            IntVect edge_type{1}; edge_type[idim] = 0;
+            m_edgecent[idim] = makeMultiCutFab(edge_type, 1, m_ngrow[2],
+                                               EBCutCellArray::edgecent_comp+idim);
+        }
+    }
     AMREX_ASSERT(m_edgecent[0] != nullptr);
     return {AMREX_D_DECL(m_edgecent[0], m_edgecent[1], m_edgecent[2])};
 }
@@ -137,8 +197,42 @@ EBDataCollection::getEdgeCent () const
 const MultiCutFab&
 EBDataCollection::getBndryNormal () const
 {
+    if (m_bndrynorm == nullptr && m_cutcells != nullptr && m_support == EBSupport::full) {
+        m_bndrynorm = makeMultiCutFab(IntVect::TheZeroVector(), AMREX_SPACEDIM, m_ngrow[2],
+                                      EBCutCellArray::bndrynorm_comp);
+    }
     AMREX_ASSERT(m_bndrynorm != nullptr);
     return *m_bndrynorm;
 }
 
+const EBCutCellData&
+EBDataCollection::getCutCellData () const
+{
+    AMREX_ASSERT(m_cutcells != nullptr);
+    return *m_cutcells;
+}
+
+MultiCutFab*
+EBDataCollection::makeMultiCutFab (IntVect const& type, int ncomp, int ngrow, int comp) const
+{
+    const BoxArray& ba = amrex::convert(m_cellflags->boxArray(), type);
+    MultiCutFab* r = new MultiCutFab(ba, m_cellflags->DistributionMap(), ncomp, ngrow,
+                                     *m_cellflags);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(r->data()); mfi.isValid(); ++mfi)
+    {
+        if (r->ok(mfi)) {
+            Array4<Real> const& a = r->array(mfi);
+            const EBCutCellArray cc = m_cutcells->const_array(mfi);
+            AMREX_HOST_DEVICE_PARALLEL_FOR_4D(mfi.fabbox(), ncomp, i, j, k, n,
+            {
+                a(i,j,k,n) = cc.get(i,j,k,comp+n);
+            });
+        }
+    }
+    return r;
+}
+
 }
@@ -15,10 +15,12 @@ EBFArrayBoxFactory::EBFArrayBoxFactory (const EB2::Level& a_level,
                                         const Geometry& a_geom,
                                         const BoxArray& a_ba,
                                         const DistributionMapping& a_dm,
-                                        const Vector<int>& a_ngrow, EBSupport a_support)
+                                        const Vector<int>& a_ngrow, EBSupport a_support,
+                                        EBCutCellStorage a_storage)
     : m_support(a_support),
       m_geom(a_geom),
-      m_ebdc(std::make_shared<EBDataCollection>(a_level,a_geom,a_ba,a_dm,a_ngrow,a_support)),
+      m_ebdc(std::make_shared<EBDataCollection>(a_level,a_geom,a_ba,a_dm,a_ngrow,a_support,
+                                                a_storage)),
       m_parent(&a_level)
 {}
 
@@ -110,12 +112,13 @@ std::unique_ptr<EBFArrayBoxFactory>
 makeEBFabFactory (const Geometry& a_geom,
                   const BoxArray& a_ba,
                   const DistributionMapping& a_dm,
-                  const Vector<int>& a_ngrow, EBSupport a_support)
+                  const Vector<int>& a_ngrow, EBSupport a_support,
+                  EBCutCellStorage a_storage)
 {
     std::unique_ptr<EBFArrayBoxFactory> r;
     const EB2::IndexSpace& index_space = EB2::IndexSpace::top();
     const EB2::Level& eb_level = index_space.getLevel(a_geom);
-    r.reset(new EBFArrayBoxFactory(eb_level, a_geom, a_ba, a_dm, a_ngrow, a_support));
+    r.reset(new EBFArrayBoxFactory(eb_level, a_geom, a_ba, a_dm, a_ngrow, a_support, a_storage));
     return r;
 }
 
@@ -123,23 +126,25 @@ std::unique_ptr<EBFArrayBoxFactory>
 makeEBFabFactory (const EB2::Level* eb_level,
                   const BoxArray& a_ba,
                   const DistributionMapping& a_dm,
-                  const Vector<int>& a_ngrow, EBSupport a_support)
+                  const Vector<int>& a_ngrow, EBSupport a_support,
+                  EBCutCellStorage a_storage)
 {
     return std::unique_ptr<EBFArrayBoxFactory> (
         new EBFArrayBoxFactory(*eb_level, eb_level->Geom(),
-                               a_ba, a_dm, a_ngrow, a_support));
+                               a_ba, a_dm, a_ngrow, a_support, a_storage));
 }
 
 std::unique_ptr<EBFArrayBoxFactory>
 makeEBFabFactory (const EB2::IndexSpace* index_space, const Geometry& a_geom,
                   const BoxArray& a_ba,
                   const DistributionMapping& a_dm,
-                  const Vector<int>& a_ngrow, EBSupport a_support)
+                  const Vector<int>& a_ngrow, EBSupport a_support,
+                  EBCutCellStorage a_storage)
 {
     const EB2::Level& eb_level = index_space->getLevel(a_geom);
     return std::unique_ptr<EBFArrayBoxFactory> (
         new EBFArrayBoxFactory(eb_level, a_geom,
-                               a_ba, a_dm, a_ngrow, a_support));
+                               a_ba, a_dm, a_ngrow, a_support, a_storage));
 }
 
 }
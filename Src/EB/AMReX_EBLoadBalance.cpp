@@ -0,0 +1,264 @@
+
+#include <AMReX_EBLoadBalance.H>
+#include <AMReX_EB2.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+#include <AMReX_Reduce.H>
+
+#include <array>
+#include <cmath>
+
+namespace amrex {
+
+EBCostModel
+EBCostModel::Default ()
+{
+    EBCostModel r;
+    ParmParse pp("ebloadbalance");
+    pp.query("regular_cost", r.regular);
+    pp.query("cut_cost", r.cut);
+    pp.query("covered_cost", r.covered);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(r.regular >= 0. && r.cut >= 0. && r.covered >= 0.,
+                                     "EBCostModel: costs must be non-negative");
+    return r;
+}
+
+EBCostModel
+EBCostModel::Fit (const FabArray<EBCellFlagFab>& flags, const LayoutData<Real>& measured_cost)
+{
+    BL_PROFILE("EBCostModel::Fit()");
+
+    AMREX_ALWAYS_ASSERT(flags.boxArray() == measured_cost.boxArray() &&
+                        flags.DistributionMap() == measured_cost.DistributionMap());
+
+    const LayoutData<EBCellCounts> counts = EBCountCells(flags);
+
+    // Normal equations of the least squares problem with one equation per
+    // box, measured_cost = regular*nregular + cut*ncut + covered*ncovered.
+    constexpr int n = 3;
+    Array<Real,n*n+n> s{};
+    for (MFIter mfi(flags, MFItInfo().DisableDeviceSync()); mfi.isValid(); ++mfi)
+    {
+        const EBCellCounts& c = counts[mfi];
+        const std::array<Real,n> a{Real(c.regular), Real(c.cut), Real(c.covered)};
+        const Real b = measured_cost[mfi];
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                s[i*n+j] += a[i]*a[j];
+            }
+            s[n*n+i] += a[i]*b;
+        }
+    }
+    ParallelDescriptor::ReduceRealSum(s.data(), s.size());
+
+    // Costs that cannot be determined or that would be negative are set
+    // to zero, and the others are fitted again.
+    std::array<bool,n> active;
+    for (int i = 0; i < n; ++i) {
+        active[i] = s[i*n+i] > 0.;
+    }
+
+    std::array<Real,n> x{};
+    for (int iter = 0; iter < n; ++iter)
+    {
+        std::array<std::array<Real,n+1>,n> m{};
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                m[i][j] = (active[i] && active[j]) ? s[i*n+j] : Real(i == j);
+            }
+            m[i][n] = active[i] ? s[n*n+i] : Real(0.);
+        }
+
+        // Gaussian elimination with partial pivoting
+        for (int k = 0; k < n; ++k) {
+            int p = k;
+            for (int i = k+1; i < n; ++i) {
+                if (std::abs(m[i][k]) > std::abs(m[p][k])) { p = i; }
+            }
+            std::swap(m[k], m[p]);
+            if (m[k][k] == 0.) { continue; }
+            for (int i = k+1; i < n; ++i) {
+                const Real f = m[i][k] / m[k][k];
+                for (int j = k; j <= n; ++j) {
+                    m[i][j] -= f*m[k][j];
+                }
+            }
+        }
+        for (int i = n-1; i >= 0; --i) {
+            Real r = m[i][n];
+            for (int j = i+1; j < n; ++j) {
+                r -= m[i][j]*x[j];
+            }
+            x[i] = (m[i][i] != 0.) ? r/m[i][i] : Real(0.);
+        }
+
+        bool done = true;
+        for (int i = 0; i < n; ++i) {
+            if (active[i] && x[i] < 0.) {
+                active[i] = false;
+                done = false;
+            }
+        }
+        if (done) { break; }
+    }
+
+    EBCostModel r;
+    r.regular = active[0] ? x[0] : Real(0.);
+    r.cut     = active[1] ? x[1] : Real(0.);
+    r.covered = active[2] ? x[2] : Real(0.);
+    return r;
+}
+
+LayoutData<EBCellCounts>
+EBCountCells (const FabArray<EBCellFlagFab>& flags)
+{
+    BL_PROFILE("EBCountCells()");
+
+    LayoutData<EBCellCounts> r(flags.boxArray(), flags.DistributionMap());
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        const EBCellFlagFab& fab = flags[mfi];
+        const FabType t = fab.getType(bx);
+        EBCellCounts& c = r[mfi];
+        c = EBCellCounts{};
+        if (t == FabType::regular) {
+            c.regular = bx.numPts();
+        } else if (t == FabType::covered) {
+            c.covered = bx.numPts();
+        } else {
+            auto const& flag = fab.const_array();
+            if (Gpu::inLaunchRegion())
+            {
+                ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_op;
+                ReduceData<Long,Long,Long> reduce_data(reduce_op);
+                using ReduceTuple = typename decltype(reduce_data)::Type;
+                reduce_op.eval(bx, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    auto f = flag(i,j,k);
+                    return {Long(f.isRegular()), Long(f.isSingleValued() || f.isMultiValued()),
+                            Long(f.isCovered())};
+                });
+                ReduceTuple hv = reduce_data.value();
+                c.regular = amrex::get<0>(hv);
+                c.cut     = amrex::get<1>(hv);
+                c.covered = amrex::get<2>(hv);
+            }
+            else
+            {
+                amrex::LoopOnCpu(bx, [=,&c] (int i, int j, int k) noexcept
+                {
+                    auto f = flag(i,j,k);
+                    if (f.isRegular()) {
+                        ++c.regular;
+                    } else if (f.isCovered()) {
+                        ++c.covered;
+                    } else {
+                        ++c.cut;
+                    }
+                });
+            }
+        }
+    }
+
+    return r;
+}
+
+LayoutData<Real>
+EBBoxCosts (const FabArray<EBCellFlagFab>& flags, const EBCostModel& model)
+{
+    const LayoutData<EBCellCounts> counts = EBCountCells(flags);
+    LayoutData<Real> r(flags.boxArray(), flags.DistributionMap());
+    for (MFIter mfi(flags, MFItInfo().DisableDeviceSync()); mfi.isValid(); ++mfi)
+    {
+        const EBCellCounts& c = counts[mfi];
+        r[mfi] = model.regular*Real(c.regular) + model.cut*Real(c.cut)
+            + model.covered*Real(c.covered);
+    }
+    return r;
+}
+
+DistributionMapping
+makeEBDistributionMapping (const FabArray<EBCellFlagFab>& flags, const EBCostModel& model)
+{
+    BL_PROFILE("makeEBDistributionMapping()");
+
+    const LayoutData<Real> cost = EBBoxCosts(flags, model);
+
+    Real current_eff, proposed_eff;
+    DistributionMapping r;
+    if (DistributionMapping::strategy() == DistributionMapping::KNAPSACK) {
+        r = DistributionMapping::makeKnapSack(cost, current_eff, proposed_eff);
+    } else {
+        r = DistributionMapping::makeSFC(cost, current_eff, proposed_eff);
+    }
+
+    int verbose = 0;
+    {
+        ParmParse pp("ebloadbalance");
+        pp.query("verbose", verbose);
+    }
+    if (verbose) {
+        amrex::Print() << "makeEBDistributionMapping: efficiency of the cost model "
+                       << current_eff << " -> " << proposed_eff << "\n";
+        if (verbose > 1) {
+            FabArray<EBCellFlagFab> newflags(flags.boxArray(), r, 1, 0);
+            newflags.ParallelCopy(flags);
+            EBPrintLoadBalance(newflags, model);
+        }
+    }
+
+    return r;
+}
+
+DistributionMapping
+makeEBDistributionMapping (const BoxArray& ba, const Geometry& geom,
+                           const EBCostModel& model, const EB2::Level* level)
+{
+    if (level == nullptr) {
+        level = &(EB2::IndexSpace::top().getLevel(geom));
+    }
+    FabArray<EBCellFlagFab> flags(ba, DistributionMapping{ba}, 1, 0);
+    level->fillEBCellFlag(flags, geom);
+    return makeEBDistributionMapping(flags, model);
+}
+
+void
+EBPrintLoadBalance (const FabArray<EBCellFlagFab>& flags, const EBCostModel& model)
+{
+    const LayoutData<EBCellCounts> counts = EBCountCells(flags);
+
+    Real ncut = 0., cost = 0.;
+    for (MFIter mfi(flags, MFItInfo().DisableDeviceSync()); mfi.isValid(); ++mfi)
+    {
+        const EBCellCounts& c = counts[mfi];
+        ncut += Real(c.cut);
+        cost += model.regular*Real(c.regular) + model.cut*Real(c.cut)
+            + model.covered*Real(c.covered);
+    }
+
+    Array<Real,2> vmin{ncut, cost};
+    Array<Real,2> vmax{ncut, cost};
+    Array<Real,2> vsum{ncut, cost};
+    ParallelDescriptor::ReduceRealMin(vmin.data(), 2);
+    ParallelDescriptor::ReduceRealMax(vmax.data(), 2);
+    ParallelDescriptor::ReduceRealSum(vsum.data(), 2);
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const Real ncut_avg = vsum[0] / nprocs;
+    const Real cost_avg = vsum[1] / nprocs;
+
+    amrex::Print() << "EB load balance over " << nprocs << " processes (min/avg/max):\n"
+                   << "    cut cells: " << vmin[0] << " / " << ncut_avg << " / " << vmax[0]
+                   << ", efficiency " << ((vmax[0] > 0.) ? ncut_avg/vmax[0] : Real(1.)) << "\n"
+                   << "    cost:      " << vmin[1] << " / " << cost_avg << " / " << vmax[1]
+                   << ", efficiency " << ((vmax[1] > 0.) ? cost_avg/vmax[1] : Real(1.)) << "\n";
+}
+
+}
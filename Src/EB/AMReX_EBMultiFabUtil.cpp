@@ -7,6 +7,7 @@
 #include <AMReX_EBMultiFabUtil_C.H>
 #include <AMReX_EBCellFlag.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_EBCutCellData.H>
 
 #include <AMReX_VisMF.H>
 
@@ -520,7 +521,6 @@ void EB_average_down_faces (const Array<const MultiFab*,AMREX_SPACEDIM>& fine,
         Dim3 dratio = ratio.dim3();
 
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>((*fine[0]).Factory());
-        const auto&  aspect = factory.getAreaFrac();
 
         if (isMFIterSafe(*fine[0], *crse[0]))
         {
@@ -546,7 +546,8 @@ void EB_average_down_faces (const Array<const MultiFab*,AMREX_SPACEDIM>& fine,
                     }
                     else
                     {
-                        Array4<Real const> const& ap = aspect[n]->const_array(mfi);
+                        EBCutCellFab cutfab(factory, mfi, amrex::refine(amrex::enclosedCells(tbx),ratio));
+                        Array4<Real const> const& ap = cutfab.areaFrac(n);
                         if (n == 0) {
                             AMREX_HOST_DEVICE_FOR_3D(tbx,i,j,k,
                             {
@@ -637,7 +638,6 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
 
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(fine.Factory());
         const auto& flags = factory.getMultiEBCellFlagFab();
-        const auto& barea = factory.getBndryArea();
 
         if (isMFIterSafe(fine, crse))
         {
@@ -658,7 +658,8 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
                     });
                 } else {
                     Array4<Real const> const& fa = fine.const_array(mfi);
-                    Array4<Real const> const& ba = barea.const_array(mfi);
+                    EBCutCellFab cutfab(factory, mfi, amrex::refine(tbx,ratio));
+                    Array4<Real const> const& ba = cutfab.bndryArea();
                     AMREX_HOST_DEVICE_FOR_3D(tbx,i,j,k,
                     {
                         eb_avgdown_boundaries(i,j,k,fa,0,ca,0,ba,dratio,ncomp);
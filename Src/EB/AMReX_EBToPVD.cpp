@@ -1,6 +1,10 @@
 #include <AMReX_EBToPVD.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Dim3.H>
+#include <AMReX_NFiles.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Utility.H>
 
 #include <string>
 #include <sstream>
@@ -8,6 +12,8 @@
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <cstdint>
+#include <cstdio>
 
 namespace {
 amrex::Real dot_product(const std::array<amrex::Real,3>& a, const std::array<amrex::Real,3>& b)
@@ -20,6 +26,35 @@ bool intersects(amrex::Real val)
    return (val > 0.0 && val < 1.0);
 }
 
+// Edge of the grid of intersection lc of cell (i,j,k), see apoints in
+// MakePolygons.  Indices up to 2^19 in magnitude are supported.
+amrex::Long edge_key(int lc, int i, int j, int k)
+{
+   constexpr int edge[12][4] = {{0,0,0,0}, {1,1,0,0}, {0,0,1,0}, {1,0,0,0},
+                                {2,0,0,0}, {2,1,0,0}, {2,1,1,0}, {2,0,1,0},
+                                {0,0,0,1}, {1,1,0,1}, {0,0,1,1}, {1,0,0,1}};
+   constexpr amrex::Long n = 1 << 20;
+   constexpr amrex::Long offset = 1 << 19;
+   AMREX_ASSERT(i+offset >= 0 && i+offset+1 < n && j+offset >= 0 && j+offset+1 < n &&
+                k+offset >= 0 && k+offset+1 < n);
+   return (((i+edge[lc][1]+offset)*n + (j+edge[lc][2]+offset))*n
+           + (k+edge[lc][3]+offset))*3 + edge[lc][0];
+}
+
+std::string byte_order()
+{
+   const int one = 1;
+   return (*reinterpret_cast<const char*>(&one) == 1) ? "LittleEndian" : "BigEndian";
+}
+
+template <class T>
+void write_array(std::ostream& os, const std::vector<T>& a)
+{
+   const std::uint64_t nbytes = a.size()*sizeof(T);
+   os.write(reinterpret_cast<const char*>(&nbytes), sizeof(nbytes));
+   os.write(reinterpret_cast<const char*>(a.data()), nbytes);
+}
+
 }
 
 namespace amrex {
@@ -28,6 +63,17 @@ void EBToPVD::EBToPolygon(const Real* problo, const Real* dx,
       const Box & bx, Array4<EBCellFlag const> const& flag,
       Array4<Real const> const& bcent,
       Array4<Real const> const& apx, Array4<Real const> const& apy, Array4<Real const> const& apz)
+{
+   std::vector<Polygon> polygons;
+   MakePolygons(problo, dx, bx, flag, bcent, apx, apy, apz, polygons);
+   AddPolygons(polygons);
+}
+
+void EBToPVD::MakePolygons(const Real* problo, const Real* dx,
+      const Box & bx, Array4<EBCellFlag const> const& flag,
+      Array4<Real const> const& bcent,
+      Array4<Real const> const& apx, Array4<Real const> const& apy, Array4<Real const> const& apz,
+      std::vector<Polygon>& polygons)
 {
    const auto lo = lbound(bx);
    const auto hi = ubound(bx);
@@ -142,7 +188,7 @@ void EBToPVD::EBToPolygon(const Real* problo, const Real* dx,
                // missing facets...
 
                if((count >=3) && (count <=6)) {
-                  m_connectivity.push_back({0,0,0,0,0,0,0});
+                  Polygon polygon;
 
                   // calculate intersection points.
                   std::array<std::array<Real,3>,12> apoints;
@@ -169,14 +215,14 @@ void EBToPVD::EBToPolygon(const Real* problo, const Real* dx,
                   // store intersections with grid cell alpha in [0,1]
                   for(int lc1 = 0; lc1 < 12; ++lc1) {
                      if(alpha_intersect[lc1]) {
-                        m_points.push_back(apoints[lc1]);
-                        int lc2 = m_connectivity.back()[0]+1;
-                        m_connectivity.back()[0] = lc2;
-                        m_connectivity.back()[lc2] = m_points.size()-1;
+                        polygon.edge[polygon.n] = edge_key(lc1, i, j, k);
+                        polygon.point[polygon.n] = apoints[lc1];
+                        ++polygon.n;
                      }
                   }
 
-                  reorder_polygon(m_points, m_connectivity.back(), n0);
+                  reorder_polygon(polygon, n0);
+                  polygons.push_back(polygon);
                }
             }
          }
@@ -237,9 +283,141 @@ void EBToPVD::WritePVTP(const int nProcs) const
       myfile.close();
    }
 }
-void EBToPVD::reorder_polygon(const std::vector<std::array<Real,3>>& lpoints,
-      std::array<int,7>& lconnect,
-      const std::array<Real,3>& lnormal)
+
+void EBToPVD::WriteEBVTPBinary(const std::string& fileprefix, int nfiles) const
+{
+   const int nprocs = ParallelDescriptor::NProcs();
+   const int myproc = ParallelDescriptor::MyProc();
+   nfiles = NFilesIter::ActualNFiles(nfiles);
+
+   std::vector<int> connectivity;
+   std::vector<int> offsets;
+   connectivity.reserve(m_connectivity.size()*6);
+   offsets.reserve(m_connectivity.size());
+   for(const auto& lconnect : m_connectivity) {
+      for(int lc2 = 1; lc2 <= lconnect[0]; ++lc2) {
+         connectivity.push_back(lconnect[lc2]);
+      }
+      offsets.push_back(static_cast<int>(connectivity.size()));
+   }
+   AMREX_ALWAYS_ASSERT(connectivity.size() <= static_cast<std::size_t>(std::numeric_limits<int>::max()));
+
+   // Numbers of points, polygons and connectivity entries of all processes
+   const std::array<Long,3> mycounts{static_cast<Long>(m_points.size()),
+                                     static_cast<Long>(offsets.size()),
+                                     static_cast<Long>(connectivity.size())};
+   std::vector<Long> counts(3*nprocs);
+#ifdef BL_USE_MPI
+   ParallelAllGather::AllGather(mycounts.data(), 3, counts.data(), ParallelDescriptor::Communicator());
+#else
+   std::copy(mycounts.begin(), mycounts.end(), counts.begin());
+#endif
+
+   const bool groupsets = false;
+   const int myfile = NFilesIter::FileNumber(nfiles, myproc, groupsets);
+
+   // The processes writing to a file do so in the order of their ranks.
+   int first = nprocs, last = -1;
+   for(int iproc = 0; iproc < nprocs; ++iproc) {
+      if(NFilesIter::FileNumber(nfiles, iproc, groupsets) == myfile) {
+         first = std::min(first, iproc);
+         last = std::max(last, iproc);
+      }
+   }
+
+   std::string const tmpprefix = fileprefix + "_vtp_";
+   for(NFilesIter nfi(nfiles, tmpprefix, groupsets, true); nfi.ReadyToWrite(); ++nfi) {
+      auto& os = nfi.Stream();
+
+      if(myproc == first) {
+         os << "<?xml version=\"1.0\"?>\n";
+         os << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\""
+            << byte_order() << "\" header_type=\"UInt64\">\n";
+         os << "<PolyData>\n";
+         Long offset = 0;
+         for(int iproc = first; iproc <= last; ++iproc) {
+            const Long npoints = counts[3*iproc];
+            const Long npolys = counts[3*iproc+1];
+            const Long nconnect = counts[3*iproc+2];
+            os << "<Piece NumberOfPoints=\"" << npoints << "\" NumberOfVerts=\"0\" "
+               << "NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\""
+               << npolys << "\">\n";
+            os << "<Points>\n";
+            os << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+               << offset << "\"/>\n";
+            os << "</Points>\n";
+            offset += sizeof(std::uint64_t) + 3*npoints*sizeof(float);
+            os << "<Polys>\n";
+            os << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\""
+               << offset << "\"/>\n";
+            offset += sizeof(std::uint64_t) + nconnect*sizeof(int);
+            os << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\""
+               << offset << "\"/>\n";
+            offset += sizeof(std::uint64_t) + npolys*sizeof(int);
+            os << "</Polys>\n";
+            os << "</Piece>\n";
+         }
+         os << "</PolyData>\n";
+         os << "<AppendedData encoding=\"raw\">\n_";
+      }
+
+      std::vector<float> points;
+      points.reserve(3*m_points.size());
+      for(const auto& point : m_points) {
+         points.push_back(static_cast<float>(point[0]));
+         points.push_back(static_cast<float>(point[1]));
+         points.push_back(static_cast<float>(point[2]));
+      }
+      write_array(os, points);
+      write_array(os, connectivity);
+      write_array(os, offsets);
+
+      if(myproc == last) {
+         os << "\n</AppendedData>\n";
+         os << "</VTKFile>\n";
+      }
+
+      os.flush();
+      if(!os.good()) {
+         amrex::FileOpenFailed(nfi.FileName());
+      }
+   }
+
+   ParallelDescriptor::Barrier();
+
+   auto filename = [&] (int ifile) -> std::string
+   {
+      return (nfiles == 1) ? fileprefix + ".vtp" : NFilesIter::FileName(ifile, fileprefix) + ".vtp";
+   };
+
+   if(myproc == first) {
+      const std::string tmpname = NFilesIter::FileName(myfile, tmpprefix);
+      if(std::rename(tmpname.c_str(), filename(myfile).c_str()) != 0) {
+         amrex::Abort("EBToPVD::WriteEBVTPBinary: failed to rename " + tmpname);
+      }
+   }
+
+   if(nfiles > 1 && ParallelDescriptor::IOProcessor()) {
+      std::ofstream pvdfile(fileprefix + ".pvd");
+      if(!pvdfile.good()) {
+         amrex::FileOpenFailed(fileprefix + ".pvd");
+      }
+      pvdfile << "<?xml version=\"1.0\"?>\n";
+      pvdfile << "<VTKFile type=\"Collection\" version=\"0.1\">\n";
+      pvdfile << "<Collection>\n";
+      for(int ifile = 0; ifile < nfiles; ++ifile) {
+         // the file names are relative to the directory of the pvd file
+         std::string name = filename(ifile);
+         name = name.substr(name.find_last_of('/')+1);
+         pvdfile << "<DataSet part=\"" << ifile << "\" file=\"" << name << "\"/>\n";
+      }
+      pvdfile << "</Collection>\n";
+      pvdfile << "</VTKFile>\n";
+   }
+
+   ParallelDescriptor::Barrier();
+}
+void EBToPVD::reorder_polygon(Polygon& polygon, const std::array<Real,3>& lnormal)
 {
    std::array<Real,3> center;
    center.fill(0.0);
@@ -254,68 +432,61 @@ void EBToPVD::reorder_polygon(const std::vector<std::array<Real,3>>& lpoints,
          longest = 1;
    }
 
-   for(int i = 1; i <= lconnect[0]; ++i) {
-      center[0] += m_points[lconnect[i]][0];
-      center[1] += m_points[lconnect[i]][1];
-      center[2] += m_points[lconnect[i]][2];
+   const int n = polygon.n;
+   auto& lpoints = polygon.point;
+
+   for(int i = 0; i < n; ++i) {
+      center[0] += lpoints[i][0];
+      center[1] += lpoints[i][1];
+      center[2] += lpoints[i][2];
    }
-   center = {center[0]/lconnect[0], center[1]/lconnect[0], center[2]/lconnect[0]};
+   center = {center[0]/n, center[1]/n, center[2]/n};
 
-   int pi, pk;
-   Real ref_angle, angle;
-   if(longest == 0)
-   {
-      for(int i = 1; i <= lconnect[0]-1; ++i) {
-         pi = lconnect[i];
-         ref_angle = std::atan2(lpoints[pi][2]-center[2], lpoints[pi][1]-center[1]);
-         for(int k = i+1; k <= lconnect[0]; ++k) {
-            pk = lconnect[k];
-            angle = std::atan2(lpoints[pk][2]-center[2], lpoints[pk][1]-center[1]);
-            if(angle < ref_angle) {
-               ref_angle = angle;
-               lconnect[k] = pi;
-               lconnect[i] = pk;
-               pi = pk;
-            }
-         }
-      }
+   // The polygon is sorted by the angle in the plane normal to the
+   // direction of the longest component of the normal.
+   int d0, d1;
+   if(longest == 0) {
+      d0 = 1; d1 = 2;
    }
    else if(longest == 1) {
-      for(int i = 1; i <= lconnect[0]-1; ++i) {
-         pi = lconnect[i];
-         ref_angle = std::atan2(lpoints[pi][0]-center[0], lpoints[pi][2]-center[2]);
-         for(int k = i+1; k <= lconnect[0]; ++k) {
-            pk = lconnect[k];
-            angle = std::atan2(lpoints[pk][0]-center[0], lpoints[pk][2]-center[2]);
-            if(angle < ref_angle) {
-               ref_angle = angle;
-               lconnect[k] = pi;
-               lconnect[i] = pk;
-               pi = pk;
-            }
+      d0 = 2; d1 = 0;
+   }
+   else {
+      d0 = 0; d1 = 1;
+   }
+
+   Real ref_angle, angle;
+   for(int i = 0; i < n-1; ++i) {
+      ref_angle = std::atan2(lpoints[i][d1]-center[d1], lpoints[i][d0]-center[d0]);
+      for(int k = i+1; k < n; ++k) {
+         angle = std::atan2(lpoints[k][d1]-center[d1], lpoints[k][d0]-center[d0]);
+         if(angle < ref_angle) {
+            ref_angle = angle;
+            std::swap(lpoints[i], lpoints[k]);
+            std::swap(polygon.edge[i], polygon.edge[k]);
          }
       }
    }
-   else if(longest == 2) {
-      for(int i = 1; i <= lconnect[0]-1; ++i) {
-         pi = lconnect[i];
-         ref_angle = std::atan2(lpoints[pi][1]-center[1], lpoints[pi][0]-center[0]);
-         for(int k = i+1; k <= lconnect[0]; ++k) {
-            pk = lconnect[k];
-            angle = std::atan2(lpoints[pk][1]-center[1], lpoints[pk][0]-center[0]);
-            if(angle < ref_angle) {
-               ref_angle = angle;
-               lconnect[k] = pi;
-               lconnect[i] = pk;
-               pi = pk;
-            }
+}
+
+void EBToPVD::AddPolygons(const std::vector<Polygon>& polygons)
+{
+   for(const auto& polygon : polygons) {
+      std::array<int,7> lconnect;
+      lconnect[0] = polygon.n;
+      for(int i = 0; i < polygon.n; ++i) {
+         auto r = m_point_index.emplace(polygon.edge[i], static_cast<int>(m_points.size()));
+         if(r.second) {
+            m_points.push_back(polygon.point[i]);
          }
+         lconnect[i+1] = r.first->second;
       }
+      m_connectivity.push_back(lconnect);
    }
 }
 
 void EBToPVD::calc_hesse(Real& distance, std::array<Real,3>& n0, Real& p,
-      const std::array<Real,3>& normal, const std::array<Real,3>& centroid) const
+      const std::array<Real,3>& normal, const std::array<Real,3>& centroid)
 {
    Real sign_of_dist;
 
@@ -337,7 +508,7 @@ void EBToPVD::calc_hesse(Real& distance, std::array<Real,3>& n0, Real& p,
 void EBToPVD::calc_alpha(std::array<Real,12>& alpha,
       const std::array<Real,3>& n0, Real p,
       const std::array<std::array<Real,3>,8>& vertex,
-      const Real* dx) const
+      const Real* dx)
 {
    // default (large) value
    std::fill(alpha.begin(), alpha.end(), 10.0);
@@ -368,7 +539,7 @@ void EBToPVD::calc_alpha(std::array<Real,12>& alpha,
 }
 
 void EBToPVD::calc_intersects(int& int_count, std::array<bool,12>& intersects_flags,
-      const std::array<Real,12>& alpha) const
+      const std::array<Real,12>& alpha)
 {
    int_count = 0;
    std::fill(intersects_flags.begin(), intersects_flags.end(), false);
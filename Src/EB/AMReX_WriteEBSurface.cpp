@@ -4,6 +4,7 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiCutFab.H>
 #include <AMReX_EBFArrayBox.H>
+#include <AMReX_EBCutCellData.H>
 #include <AMReX_EB2.H>
 #include <AMReX_WriteEBSurface.H>
 #include <AMReX_EBToPVD.H>
@@ -13,50 +14,73 @@ namespace amrex {
 void WriteEBSurface (const BoxArray & ba, const DistributionMapping & dmap, const Geometry & geom,
                      const EBFArrayBoxFactory * ebf) {
 
+    BL_PROFILE("WriteEBSurface()");
+
+    bool binary = false;
+    int nfiles = 1;
+    {
+        ParmParse pp("ebsurface");
+        pp.query("binary", binary);
+        pp.query("nfiles", nfiles);
+    }
+
     EBToPVD eb_to_pvd;
 
     const Real* dx     = geom.CellSize();
     const Real* problo = geom.ProbLo();
 
-    MultiFab mf_ba(ba, dmap, 1, 0, MFInfo(), *ebf);
+    const auto& flags = ebf->getMultiEBCellFlagFab();
+    AMREX_ALWAYS_ASSERT(flags.boxArray() == ba && flags.DistributionMap() == dmap);
+
+    // The polygons of each box are computed independently and then added
+    // in the order of the boxes, so that the output does not depend on the
+    // number of threads.
+    Vector<std::vector<EBToPVD::Polygon> > polygons(flags.local_size());
 
-    for (MFIter mfi(mf_ba); mfi.isValid(); ++mfi) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(flags, MFItInfo().SetDynamic(true)); mfi.isValid(); ++mfi) {
 
-        const auto & sfab    = static_cast<EBFArrayBox const &>(mf_ba[mfi]);
-        const auto & my_flag = sfab.getEBCellFlagFab();
+        const auto & my_flag = flags[mfi];
 
         const Box & bx = mfi.validbox();
 
         if (my_flag.getType(bx) == FabType::covered ||
             my_flag.getType(bx) == FabType::regular) continue;
 
-        std::array<const MultiCutFab *, AMREX_SPACEDIM> areafrac;
-        const MultiCutFab * bndrycent;
+        EBCutCellFab cutfab(*ebf, mfi, bx);
 
-        areafrac  =   ebf->getAreaFrac();
-        bndrycent = &(ebf->getBndryCent());
-
-        eb_to_pvd.EBToPolygon(
+        EBToPVD::MakePolygons(
                 problo, dx,
                 bx, my_flag.const_array(),
-                bndrycent->const_array(mfi),
-                areafrac[0]->const_array(mfi),
-                areafrac[1]->const_array(mfi),
-                areafrac[2]->const_array(mfi));
+                cutfab.bndryCent(),
+                cutfab.areaFrac(0),
+                cutfab.areaFrac(1),
+                cutfab.areaFrac(2),
+                polygons[mfi.LocalIndex()]);
+    }
+
+    for (auto const& p : polygons) {
+        eb_to_pvd.AddPolygons(p);
     }
+    polygons.clear();
 
     int cpu = ParallelDescriptor::MyProc();
     int nProcs = ParallelDescriptor::NProcs();
 
-    eb_to_pvd.WriteEBVTP(cpu);
+    if (binary) {
+        eb_to_pvd.WriteEBVTPBinary("eb", nfiles);
+    } else {
+        eb_to_pvd.WriteEBVTP(cpu);
 
-    if(ParallelDescriptor::IOProcessor())
-        eb_to_pvd.WritePVTP(nProcs);
+        if(ParallelDescriptor::IOProcessor())
+            eb_to_pvd.WritePVTP(nProcs);
+    }
 
-    for (MFIter mfi(mf_ba); mfi.isValid(); ++mfi) {
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi) {
 
-        const auto & sfab    = static_cast<EBFArrayBox const &>(mf_ba[mfi]);
-        const auto & my_flag = sfab.getEBCellFlagFab();
+        const auto & my_flag = flags[mfi];
 
         const Box & bx = mfi.validbox();
 
@@ -524,6 +524,145 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
     }
 }
 
+bool
+MLABecLaplacian::supportsFusedSmoothResRestrict (int amrlev, int mglev) const
+{
+    // Semi-coarsened levels are smoothed with line solves in Fsmooth.
+    bool regular_coarsening = true;
+    if (amrlev == 0 && mglev > 0) {
+        regular_coarsening = mg_coarsen_ratio_vec[mglev-1] == mg_coarsen_ratio;
+    }
+    return regular_coarsening && !m_overset_mask[amrlev][mglev];
+}
+
+void
+MLABecLaplacian::FsmoothResRestrict (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
+                                     MultiFab& crse_res) const
+{
+    BL_PROFILE("MLABecLaplacian::FsmoothResRestrict()");
+
+#if (AMREX_SPACEDIM == 1)
+    amrex::ignore_unused(amrlev,mglev,sol,rhs,crse_res);
+#else
+    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
+    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
+                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
+                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
+    const auto& undrrelxr = m_undrrelxr[amrlev][mglev];
+    const auto& maskvals  = m_maskvals [amrlev][mglev];
+
+    OrientationIter oitr;
+
+    const FabSet& f0 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f1 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f2 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f3 = undrrelxr[oitr()]; ++oitr;
+#if (AMREX_SPACEDIM > 2)
+    const FabSet& f4 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f5 = undrrelxr[oitr()]; ++oitr;
+#endif
+
+    const MultiMask& mm0 = maskvals[0];
+    const MultiMask& mm1 = maskvals[1];
+    const MultiMask& mm2 = maskvals[2];
+    const MultiMask& mm3 = maskvals[3];
+#if (AMREX_SPACEDIM > 2)
+    const MultiMask& mm4 = maskvals[4];
+    const MultiMask& mm5 = maskvals[5];
+#endif
+
+    const int nc = getNComp();
+    const Real* h = m_geom[amrlev][mglev].CellSize();
+    AMREX_D_TERM(const Real dhx = m_b_scalar/(h[0]*h[0]);,
+                 const Real dhy = m_b_scalar/(h[1]*h[1]);,
+                 const Real dhz = m_b_scalar/(h[2]*h[2]));
+    const Real alpha = m_a_scalar;
+    const Real beta = m_b_scalar;
+    const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(sol,fusedTileInfo()); mfi.isValid(); ++mfi)
+    {
+        const Box& tbx = mfi.tilebox();
+        const Box& vbx = mfi.validbox();
+        const auto& solnfab = sol.array(mfi);
+        const auto& rhsfab  = rhs.const_array(mfi);
+        const auto& crsefab = crse_res.array(mfi);
+        const auto& afab    = acoef.const_array(mfi);
+
+        AMREX_D_TERM(const auto& bxfab = bxcoef.const_array(mfi);,
+                     const auto& byfab = bycoef.const_array(mfi);,
+                     const auto& bzfab = bzcoef.const_array(mfi););
+
+        const auto& m0 = mm0.array(mfi);
+        const auto& m1 = mm1.array(mfi);
+        const auto& m2 = mm2.array(mfi);
+        const auto& m3 = mm3.array(mfi);
+        const auto& f0fab = f0.array(mfi);
+        const auto& f1fab = f1.array(mfi);
+        const auto& f2fab = f2.array(mfi);
+        const auto& f3fab = f3.array(mfi);
+#if (AMREX_SPACEDIM > 2)
+        const auto& m4 = mm4.array(mfi);
+        const auto& m5 = mm5.array(mfi);
+        const auto& f4fab = f4.array(mfi);
+        const auto& f5fab = f5.array(mfi);
+#endif
+
+        abec_gsrb_res_restrict(tbx, crsefab, solnfab, rhsfab, alpha, afab,
+                               AMREX_D_DECL(dhx, dhy, dhz),
+                               AMREX_D_DECL(bxfab, byfab, bzfab),
+                               AMREX_D_DECL(m0,m2,m4),
+                               AMREX_D_DECL(m1,m3,m5),
+                               AMREX_D_DECL(f0fab,f2fab,f4fab),
+                               AMREX_D_DECL(f1fab,f3fab,f5fab),
+                               vbx, nc, dxinv, beta);
+    }
+#endif
+}
+
+void
+MLABecLaplacian::FresRestrictTileBndry (int amrlev, int mglev, const MultiFab& sol,
+                                        const MultiFab& rhs, MultiFab& crse_res) const
+{
+    BL_PROFILE("MLABecLaplacian::FresRestrictTileBndry()");
+
+#if (AMREX_SPACEDIM == 1)
+    amrex::ignore_unused(amrlev,mglev,sol,rhs,crse_res);
+#else
+    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
+    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
+                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
+                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
+
+    const int nc = getNComp();
+    const Real alpha = m_a_scalar;
+    const Real beta = m_b_scalar;
+    const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(sol,fusedTileInfo()); mfi.isValid(); ++mfi)
+    {
+        const Box& cbx = amrex::coarsen(mfi.tilebox(),2);
+        const auto& solnfab = sol.const_array(mfi);
+        const auto& rhsfab  = rhs.const_array(mfi);
+        const auto& crsefab = crse_res.array(mfi);
+        const auto& afab    = acoef.const_array(mfi);
+        AMREX_D_TERM(const auto& bxfab = bxcoef.const_array(mfi);,
+                     const auto& byfab = bycoef.const_array(mfi);,
+                     const auto& bzfab = bzcoef.const_array(mfi););
+
+        mlabeclap_res_restrict_shell(cbx, crsefab, solnfab, rhsfab, alpha, afab,
+                                     AMREX_D_DECL(bxfab, byfab, bzfab),
+                                     dxinv, beta, nc);
+    }
+#endif
+}
+
 void
 MLABecLaplacian::FFlux (int amrlev, const MFIter& mfi,
                         const Array<FArrayBox*,AMREX_SPACEDIM>& flux,
@@ -0,0 +1,782 @@
+#include <AMReX_MLAMGSolver.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelContext.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+
+using CSR = MLAMGSolver::CSR;
+
+void
+csr_matvec (const CSR& A, const Vector<Real>& x, Vector<Real>& y)
+{
+    for (int i = 0; i < A.nrows; ++i) {
+        Real s = 0.0;
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            s += A.val[jj] * x[A.col[jj]];
+        }
+        y[i] = s;
+    }
+}
+
+// r = b - A*x
+void
+csr_residual (const CSR& A, const Vector<Real>& x, const Vector<Real>& b, Vector<Real>& r)
+{
+    for (int i = 0; i < A.nrows; ++i) {
+        Real s = b[i];
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            s -= A.val[jj] * x[A.col[jj]];
+        }
+        r[i] = s;
+    }
+}
+
+CSR
+csr_transpose (const CSR& A)
+{
+    CSR T;
+    T.nrows = A.ncols;
+    T.ncols = A.nrows;
+    T.row_ptr.assign(T.nrows+1, 0);
+    for (int jj = 0, N = A.row_ptr[A.nrows]; jj < N; ++jj) {
+        ++T.row_ptr[A.col[jj]+1];
+    }
+    for (int i = 0; i < T.nrows; ++i) {
+        T.row_ptr[i+1] += T.row_ptr[i];
+    }
+    T.col.resize(T.row_ptr[T.nrows]);
+    T.val.resize(T.row_ptr[T.nrows]);
+    Vector<int> pos(T.row_ptr.begin(), T.row_ptr.end()-1);
+    for (int i = 0; i < A.nrows; ++i) {
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            const int p = pos[A.col[jj]]++;
+            T.col[p] = i;
+            T.val[p] = A.val[jj];
+        }
+    }
+    return T;
+}
+
+// C = A*B with a dense accumulator (Gustavson's algorithm)
+CSR
+csr_matmul (const CSR& A, const CSR& B)
+{
+    AMREX_ASSERT(A.ncols == B.nrows);
+    CSR C;
+    C.nrows = A.nrows;
+    C.ncols = B.ncols;
+    C.row_ptr.resize(C.nrows+1);
+    C.row_ptr[0] = 0;
+    Vector<int> marker(B.ncols, -1);
+    Vector<Real> acc(B.ncols, 0.0);
+    Vector<int> cols;
+    for (int i = 0; i < A.nrows; ++i) {
+        cols.clear();
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            const int j = A.col[jj];
+            const Real a = A.val[jj];
+            for (int kk = B.row_ptr[j]; kk < B.row_ptr[j+1]; ++kk) {
+                const int k = B.col[kk];
+                if (marker[k] != i) {
+                    marker[k] = i;
+                    acc[k] = 0.0;
+                    cols.push_back(k);
+                }
+                acc[k] += a * B.val[kk];
+            }
+        }
+        std::sort(cols.begin(), cols.end());
+        for (int k : cols) {
+            if (acc[k] != Real(0.0)) {
+                C.col.push_back(k);
+                C.val.push_back(acc[k]);
+            }
+        }
+        C.row_ptr[i+1] = static_cast<int>(C.col.size());
+    }
+    return C;
+}
+
+// Standard three-phase aggregation on the strength-of-connection graph.
+// Returns the number of aggregates.  Decoupled points (no off-diagonal
+// entries) are left out of the coarse space (agg = -1); they are handled by
+// smoothing.  Points that are only weakly connected join the aggregate of
+// their strongest neighbor so that the near null space (constants) is
+// still represented on the coarse level.
+int
+aggregate (const CSR& A, const Vector<Real>& diag, Real theta, Vector<int>& agg)
+{
+    const int n = A.nrows;
+    Vector<int> s_ptr(n+1, 0);
+    Vector<int> s_col;
+    s_col.reserve(A.col.size());
+    for (int i = 0; i < n; ++i) {
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            const int j = A.col[jj];
+            if (j != i && std::abs(A.val[jj]) >= theta*std::sqrt(std::abs(diag[i]*diag[j]))) {
+                s_col.push_back(j);
+            }
+        }
+        s_ptr[i+1] = static_cast<int>(s_col.size());
+    }
+
+    constexpr int unagg = -2;
+    agg.assign(n, unagg);
+    int nagg = 0;
+
+    for (int i = 0; i < n; ++i) {
+        bool decoupled = true;
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            if (A.col[jj] != i && A.val[jj] != Real(0.0)) { decoupled = false; break; }
+        }
+        if (decoupled) { agg[i] = -1; }
+    }
+
+    // Phase 1: root points whose strong neighborhood is untouched
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unagg || s_ptr[i] == s_ptr[i+1]) continue;
+        bool free_nbhd = true;
+        for (int jj = s_ptr[i]; jj < s_ptr[i+1]; ++jj) {
+            if (agg[s_col[jj]] >= 0) { free_nbhd = false; break; }
+        }
+        if (free_nbhd) {
+            agg[i] = nagg;
+            for (int jj = s_ptr[i]; jj < s_ptr[i+1]; ++jj) {
+                agg[s_col[jj]] = nagg;
+            }
+            ++nagg;
+        }
+    }
+
+    // Phase 2: attach leftovers to a neighboring phase-1 aggregate
+    Vector<int> agg1 = agg;
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unagg) continue;
+        for (int jj = s_ptr[i]; jj < s_ptr[i+1]; ++jj) {
+            if (agg1[s_col[jj]] >= 0) {
+                agg[i] = agg1[s_col[jj]];
+                break;
+            }
+        }
+    }
+
+    // Phase 3: whatever remains forms new aggregates
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unagg || s_ptr[i] == s_ptr[i+1]) continue;
+        agg[i] = nagg;
+        for (int jj = s_ptr[i]; jj < s_ptr[i+1]; ++jj) {
+            if (agg[s_col[jj]] == unagg) { agg[s_col[jj]] = nagg; }
+        }
+        ++nagg;
+    }
+
+    // Weakly connected points go with their strongest aggregated neighbor
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] != unagg) continue;
+        Real amax = 0.0;
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            const int j = A.col[jj];
+            if (j != i && agg[j] >= 0 && std::abs(A.val[jj]) > amax) {
+                amax = std::abs(A.val[jj]);
+                agg[i] = agg[j];
+            }
+        }
+        if (agg[i] == unagg) { agg[i] = nagg++; }
+    }
+
+    return nagg;
+}
+
+// Smoothed prolongator P = (I - omega D^{-1} A) P0, where P0 is the
+// piecewise constant interpolation defined by the aggregates.
+CSR
+smoothed_prolongator (const CSR& A, const Vector<Real>& diag, const Vector<int>& agg, int nagg)
+{
+    const int n = A.nrows;
+
+    // Gershgorin bound on the spectral radius of D^{-1}A
+    Real rho = 0.0;
+    for (int i = 0; i < n; ++i) {
+        Real s = 0.0;
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            s += std::abs(A.val[jj]);
+        }
+        rho = std::max(rho, s/std::abs(diag[i]));
+    }
+    const Real omega = (rho > Real(0.0)) ? Real(4./3.)/rho : Real(0.0);
+
+    CSR P;
+    P.nrows = n;
+    P.ncols = nagg;
+    P.row_ptr.resize(n+1);
+    P.row_ptr[0] = 0;
+    Vector<int> marker(nagg, -1);
+    Vector<Real> acc(nagg, 0.0);
+    Vector<int> cols;
+    for (int i = 0; i < n; ++i) {
+        cols.clear();
+        if (agg[i] >= 0) {
+            marker[agg[i]] = i;
+            acc[agg[i]] = 1.0;
+            cols.push_back(agg[i]);
+        }
+        const Real w = omega/diag[i];
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            const int a = agg[A.col[jj]];
+            if (a < 0) continue;
+            if (marker[a] != i) {
+                marker[a] = i;
+                acc[a] = 0.0;
+                cols.push_back(a);
+            }
+            acc[a] -= w * A.val[jj];
+        }
+        std::sort(cols.begin(), cols.end());
+        for (int a : cols) {
+            if (acc[a] != Real(0.0)) {
+                P.col.push_back(a);
+                P.val.push_back(acc[a]);
+            }
+        }
+        P.row_ptr[i+1] = static_cast<int>(P.col.size());
+    }
+    return P;
+}
+
+Vector<Real>
+get_diagonal (CSR& A)
+{
+    Vector<Real> diag(A.nrows, 0.0);
+    for (int i = 0; i < A.nrows; ++i) {
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            if (A.col[jj] == i) { diag[i] += A.val[jj]; }
+        }
+    }
+    // Rows with a zero diagonal (e.g., covered cells) are decoupled
+    // unknowns.  Give them a unit diagonal so that smoothing is defined.
+    for (int i = 0; i < A.nrows; ++i) {
+        if (diag[i] == Real(0.0)) {
+            diag[i] = 1.0;
+            for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+                if (A.col[jj] == i) { A.val[jj] = 1.0; }
+            }
+        }
+    }
+    return diag;
+}
+
+// Neighbor index along one direction; periodic directions wrap around.
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+int amg_nbr (int i, int off, int lo, int len, int is_periodic) noexcept
+{
+    int ii = i + off - lo;
+    if (is_periodic) {
+        ii = ((ii % len) + len) % len;
+    }
+    return ii;
+}
+
+}
+
+MLAMGSolver::MLAMGSolver (MLLinOp& a_lp)
+    : Lp(a_lp),
+      amrlev(0),
+      mglev(a_lp.NMGLevels(0)-1)
+{}
+
+MLAMGSolver::~MLAMGSolver ()
+{}
+
+void
+MLAMGSolver::assemble (const MultiFab& sol, CSR& A)
+{
+    BL_PROFILE("MLAMGSolver::assemble()");
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+    const Geometry& geom = Lp.Geom(amrlev, mglev);
+    const Box& domain = geom.Domain();
+
+    // The number of colors in each direction must separate the three
+    // neighbors of every cell, including across periodic boundaries.
+    IntVect period(3);
+    IntVect is_periodic(0);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (geom.isPeriodic(idim)) {
+            is_periodic[idim] = 1;
+            const int n = domain.length(idim);
+            period[idim] = n;
+            for (int p = 3; p < n; ++p) {
+                const int r = n % p;
+                if (r == 0 || r >= 3) {
+                    period[idim] = p;
+                    break;
+                }
+            }
+        }
+    }
+    const int ncolors = AMREX_D_TERM(period[0],*period[1],*period[2]);
+    constexpr int nstencil = AMREX_D_TERM(3,*3,*3);
+
+    MultiFab in(ba, dm, 1, sol.nGrow(), MFInfo(), factory);
+    MultiFab out(ba, dm, 1, 0, MFInfo(), factory);
+    MultiFab stencil(ba, dm, nstencil, 0, MFInfo(), factory);
+    stencil.setVal(0.0);
+
+    const auto dlo = amrex::lbound(domain);
+    const auto dlen = amrex::length(domain);
+
+    for (int color = 0; color < ncolors; ++color)
+    {
+        const IntVect c(AMREX_D_DECL(color % period[0],
+                                     (color / period[0]) % period[1],
+                                     color / (period[0]*period[1])));
+        in.setVal(0.0);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(in,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            auto const& a = in.array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j,k);
+                if (AMREX_D_TERM(   (i-dlo.x) % period[0] == c[0],
+                                 && (j-dlo.y) % period[1] == c[1],
+                                 && (k-dlo.z) % period[2] == c[2])) {
+                    a(i,j,k) = 1.0;
+                }
+            });
+        }
+
+        Lp.apply(amrlev, mglev, out, in, MLLinOp::BCMode::Homogeneous,
+                 MLLinOp::StateMode::Correction);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(out,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            auto const& o = out.const_array(mfi);
+            auto const& s = stencil.array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::ignore_unused(j,k);
+                // Exactly one physical neighbor has this color.  If several
+                // offsets alias the same (periodic) cell, the first one
+                // takes the coefficient and the others stay zero.
+                for (int n = 0; n < nstencil; ++n) {
+                    const int ioff = n % 3 - 1;
+#if (AMREX_SPACEDIM > 1)
+                    const int joff = (n / 3) % 3 - 1;
+#endif
+#if (AMREX_SPACEDIM > 2)
+                    const int koff = n / 9 - 1;
+#endif
+                    const int ii = amg_nbr(i, ioff, dlo.x, dlen.x, is_periodic[0]);
+                    bool match = (ii >= 0 && ii < dlen.x && ii % period[0] == c[0]);
+#if (AMREX_SPACEDIM > 1)
+                    const int jj = amg_nbr(j, joff, dlo.y, dlen.y, is_periodic[1]);
+                    match = match && (jj >= 0 && jj < dlen.y && jj % period[1] == c[1]);
+#endif
+#if (AMREX_SPACEDIM > 2)
+                    const int kk = amg_nbr(k, koff, dlo.z, dlen.z, is_periodic[2]);
+                    match = match && (kk >= 0 && kk < dlen.z && kk % period[2] == c[2]);
+#endif
+                    if (match) {
+                        s(i,j,k,n) = o(i,j,k);
+                        break;
+                    }
+                }
+            });
+        }
+    }
+
+    // Gather everything onto the root rank
+    MultiFab root_stencil(ba, m_root_dm, nstencil, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    root_stencil.ParallelCopy(stencil);
+
+    if (ParallelDescriptor::MyProc() != m_root) return;
+
+    Vector<int> gid(domain.numPts(), -1);
+    for (int ibox = 0, N = ba.size(); ibox < N; ++ibox) {
+        int id = m_box_offset[ibox];
+        const Box& bx = ba[ibox];
+        AMREX_LOOP_3D(bx, i, j, k,
+        {
+            gid[domain.index(IntVect(AMREX_D_DECL(i,j,k)))] = id++;
+        });
+    }
+
+    const int nrows = static_cast<int>(ba.numPts());
+    A.nrows = nrows;
+    A.ncols = nrows;
+    A.row_ptr.resize(nrows+1);
+    A.row_ptr[0] = 0;
+    A.col.clear();
+    A.val.clear();
+    A.col.reserve(static_cast<Long>(nrows)*nstencil);
+    A.val.reserve(static_cast<Long>(nrows)*nstencil);
+
+    int row = 0;
+    for (int ibox = 0, N = ba.size(); ibox < N; ++ibox) {
+        const Box& bx = ba[ibox];
+        auto const& s = root_stencil.const_array(ibox);
+        AMREX_LOOP_3D(bx, i, j, k,
+        {
+            amrex::ignore_unused(j,k);
+            // The diagonal is always stored so that decoupled rows can
+            // be given a unit diagonal later.
+            const int first = static_cast<int>(A.col.size());
+            A.col.push_back(row);
+            A.val.push_back(0.0);
+            for (int n = 0; n < nstencil; ++n) {
+                const Real v = s(i,j,k,n);
+                if (v == Real(0.0)) continue;
+                IntVect iv(AMREX_D_DECL(amg_nbr(i, n%3-1, dlo.x, dlen.x, is_periodic[0]),
+                                        amg_nbr(j, (n/3)%3-1, dlo.y, dlen.y, is_periodic[1]),
+                                        amg_nbr(k, n/9-1, dlo.z, dlen.z, is_periodic[2])));
+                iv += domain.smallEnd();
+                const int colid = gid[domain.index(iv)];
+                AMREX_ASSERT(colid >= 0);
+                auto it = std::find(A.col.begin()+first, A.col.end(), colid);
+                if (it == A.col.end()) {
+                    A.col.push_back(colid);
+                    A.val.push_back(v);
+                } else {
+                    A.val[it-A.col.begin()] += v;
+                }
+            }
+            A.row_ptr[++row] = static_cast<int>(A.col.size());
+        });
+    }
+}
+
+void
+MLAMGSolver::buildHierarchy (CSR&& A)
+{
+    BL_PROFILE("MLAMGSolver::buildHierarchy()");
+
+    m_levels.clear();
+    m_levels.emplace_back();
+    m_levels[0].A = std::move(A);
+
+    for (int lev = 0; lev < max_levels-1; ++lev)
+    {
+        Level& L = m_levels[lev];
+        L.diag = get_diagonal(L.A);
+        const int n = L.A.nrows;
+        L.x.resize(n);
+        L.b.resize(n);
+        L.r.resize(n);
+
+        if (n <= max_coarse_size) break;
+
+        Vector<int> agg;
+        const Real theta = strong_threshold * std::pow(Real(0.5), lev);
+        const int nagg = aggregate(L.A, L.diag, theta, agg);
+        if (nagg == 0 || nagg >= n) break;
+
+        L.P = smoothed_prolongator(L.A, L.diag, agg, nagg);
+        L.R = csr_transpose(L.P);
+        CSR Ac = csr_matmul(L.R, csr_matmul(L.A, L.P));
+
+        m_levels.emplace_back();
+        m_levels.back().A = std::move(Ac);
+    }
+
+    Level& C = m_levels.back();
+    if (C.diag.empty()) {
+        C.diag = get_diagonal(C.A);
+        C.x.resize(C.A.nrows);
+        C.b.resize(C.A.nrows);
+        C.r.resize(C.A.nrows);
+    }
+
+    factorCoarsest();
+
+    if (verbose > 0) {
+        amrex::Print() << "MLAMGSolver: " << m_levels.size() << " levels, unknowns:";
+        for (auto const& L : m_levels) {
+            amrex::Print() << " " << L.A.nrows;
+        }
+        amrex::Print() << "\n";
+    }
+}
+
+void
+MLAMGSolver::factorCoarsest ()
+{
+    const CSR& A = m_levels.back().A;
+    const int n = A.nrows;
+    if (n > 4*max_coarse_size) {
+        // Coarsening stalled; fall back to smoothing on the coarsest level.
+        m_lu.clear();
+        return;
+    }
+
+    m_lu.assign(static_cast<Long>(n)*n, 0.0);
+    m_piv.resize(n);
+    m_null_pivot.assign(n, 0);
+    for (int i = 0; i < n; ++i) {
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            m_lu[static_cast<Long>(i)*n+A.col[jj]] += A.val[jj];
+        }
+    }
+
+    Real amax = 0.0;
+    for (auto v : m_lu) { amax = std::max(amax, std::abs(v)); }
+    const Real tiny = amax * Real(100.)*std::numeric_limits<Real>::epsilon();
+
+    // LU with partial pivoting.  A vanishing pivot signals the null space
+    // of a singular problem; the corresponding unknown is pinned to zero.
+    for (int k = 0; k < n; ++k) {
+        int p = k;
+        Real pmax = std::abs(m_lu[static_cast<Long>(k)*n+k]);
+        for (int i = k+1; i < n; ++i) {
+            const Real v = std::abs(m_lu[static_cast<Long>(i)*n+k]);
+            if (v > pmax) { pmax = v; p = i; }
+        }
+        m_piv[k] = p;
+        if (p != k) {
+            for (int j = 0; j < n; ++j) {
+                std::swap(m_lu[static_cast<Long>(k)*n+j], m_lu[static_cast<Long>(p)*n+j]);
+            }
+        }
+        if (pmax <= tiny) {
+            m_null_pivot[k] = 1;
+            continue;
+        }
+        const Real pinv = Real(1.0)/m_lu[static_cast<Long>(k)*n+k];
+        for (int i = k+1; i < n; ++i) {
+            Real& lik = m_lu[static_cast<Long>(i)*n+k];
+            if (lik == Real(0.0)) continue;
+            lik *= pinv;
+            for (int j = k+1; j < n; ++j) {
+                m_lu[static_cast<Long>(i)*n+j] -= lik * m_lu[static_cast<Long>(k)*n+j];
+            }
+        }
+    }
+}
+
+void
+MLAMGSolver::solveCoarsest ()
+{
+    Level& C = m_levels.back();
+    const int n = C.A.nrows;
+
+    if (m_lu.empty()) {
+        std::fill(C.x.begin(), C.x.end(), Real(0.0));
+        for (int i = 0; i < 10; ++i) {
+            smooth(static_cast<int>(m_levels.size())-1, true);
+            smooth(static_cast<int>(m_levels.size())-1, false);
+        }
+        return;
+    }
+
+    Vector<Real>& x = C.x;
+    x = C.b;
+    for (int k = 0; k < n; ++k) {
+        if (m_piv[k] != k) { std::swap(x[k], x[m_piv[k]]); }
+    }
+    for (int i = 0; i < n; ++i) {
+        Real s = x[i];
+        for (int j = 0; j < i; ++j) {
+            s -= m_lu[static_cast<Long>(i)*n+j] * x[j];
+        }
+        x[i] = s;
+    }
+    for (int i = n-1; i >= 0; --i) {
+        if (m_null_pivot[i]) {
+            x[i] = 0.0;
+            continue;
+        }
+        Real s = x[i];
+        for (int j = i+1; j < n; ++j) {
+            s -= m_lu[static_cast<Long>(i)*n+j] * x[j];
+        }
+        x[i] = s / m_lu[static_cast<Long>(i)*n+i];
+    }
+}
+
+void
+MLAMGSolver::smooth (int lev, bool forward)
+{
+    Level& L = m_levels[lev];
+    const CSR& A = L.A;
+    const int n = A.nrows;
+    auto gs = [&] (int i)
+    {
+        Real s = L.b[i];
+        for (int jj = A.row_ptr[i]; jj < A.row_ptr[i+1]; ++jj) {
+            s -= A.val[jj] * L.x[A.col[jj]];
+        }
+        L.x[i] += s / L.diag[i];
+    };
+    if (forward) {
+        for (int i = 0; i < n; ++i) { gs(i); }
+    } else {
+        for (int i = n-1; i >= 0; --i) { gs(i); }
+    }
+}
+
+void
+MLAMGSolver::vcycle (int lev)
+{
+    if (lev == static_cast<int>(m_levels.size())-1) {
+        solveCoarsest();
+        return;
+    }
+
+    Level& L = m_levels[lev];
+    Level& C = m_levels[lev+1];
+
+    for (int i = 0; i < num_sweeps; ++i) { smooth(lev, true); }
+
+    csr_residual(L.A, L.x, L.b, L.r);
+    csr_matvec(L.R, L.r, C.b);
+    std::fill(C.x.begin(), C.x.end(), Real(0.0));
+
+    vcycle(lev+1);
+
+    for (int i = 0; i < L.P.nrows; ++i) {
+        Real s = 0.0;
+        for (int jj = L.P.row_ptr[i]; jj < L.P.row_ptr[i+1]; ++jj) {
+            s += L.P.val[jj] * C.x[L.P.col[jj]];
+        }
+        L.x[i] += s;
+    }
+
+    for (int i = 0; i < num_sweeps; ++i) { smooth(lev, false); }
+}
+
+void
+MLAMGSolver::setup (const MultiFab& sol)
+{
+    BL_PROFILE("MLAMGSolver::setup()");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(Lp.isCellCentered(),
+                                     "MLAMGSolver only supports cell-centered operators");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(Lp.getNComp() == 1,
+                                     "MLAMGSolver doesn't work with ncomp > 1");
+
+    const BoxArray& ba = sol.boxArray();
+    const int nboxes = ba.size();
+
+    m_root = sol.DistributionMap()[0];
+    m_root_dm = DistributionMapping(Vector<int>(nboxes, m_root));
+
+    m_box_offset.resize(nboxes);
+    Long offset = 0;
+    for (int ibox = 0; ibox < nboxes; ++ibox) {
+        m_box_offset[ibox] = static_cast<int>(offset);
+        offset += ba[ibox].numPts();
+    }
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(offset < static_cast<Long>(std::numeric_limits<int>::max()),
+                                     "MLAMGSolver: bottom level too large");
+
+    CSR A;
+    assemble(sol, A);
+
+    if (ParallelDescriptor::MyProc() == m_root) {
+        buildHierarchy(std::move(A));
+    }
+
+    m_setup = true;
+}
+
+int
+MLAMGSolver::solve (MultiFab& sol, const MultiFab& rhs, Real eps_rel, Real eps_abs)
+{
+    BL_PROFILE("MLAMGSolver::solve()");
+
+    if (!m_setup) { setup(sol); }
+
+    const BoxArray& ba = sol.boxArray();
+
+    MultiFab root_rhs(ba, m_root_dm, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    MultiFab root_sol(ba, m_root_dm, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    root_rhs.ParallelCopy(rhs, 0, 0, 1);
+
+    int status[2] = {0, 0};
+
+    if (ParallelDescriptor::MyProc() == m_root)
+    {
+        Level& L = m_levels[0];
+        for (int ibox = 0, N = ba.size(); ibox < N; ++ibox) {
+            int id = m_box_offset[ibox];
+            auto const& b = root_rhs.const_array(ibox);
+            AMREX_LOOP_3D(ba[ibox], i, j, k,
+            {
+                L.b[id++] = b(i,j,k);
+            });
+        }
+
+        Real bnorm = 0.0;
+        for (auto v : L.b) { bnorm = std::max(bnorm, std::abs(v)); }
+        const Real target = std::max(eps_rel*bnorm, eps_abs);
+
+        std::fill(L.x.begin(), L.x.end(), Real(0.0));
+        Real rnorm = bnorm;
+        int ret = 2;
+        int it = 0;
+        if (rnorm <= target) {
+            ret = 0;
+        } else {
+            // vcycle overwrites L.r with the pre-smoothed residual, so the
+            // true residual is recomputed into a separate buffer.
+            Vector<Real> r(L.A.nrows);
+            for (it = 1; it <= maxiter; ++it) {
+                vcycle(0);
+                csr_residual(L.A, L.x, L.b, r);
+                rnorm = 0.0;
+                for (auto v : r) { rnorm = std::max(rnorm, std::abs(v)); }
+                if (verbose > 1) {
+                    amrex::AllPrint() << "MLAMGSolver: Iteration " << it
+                                      << " rnorm " << rnorm << "\n";
+                }
+                if (rnorm <= target) {
+                    ret = 0;
+                    break;
+                }
+            }
+            it = std::min(it, maxiter);
+        }
+
+        if (verbose > 0) {
+            amrex::AllPrint() << "MLAMGSolver: Final iter " << it
+                              << " resid " << rnorm << " target " << target << "\n";
+        }
+
+        for (int ibox = 0, N = ba.size(); ibox < N; ++ibox) {
+            int id = m_box_offset[ibox];
+            auto const& x = root_sol.array(ibox);
+            AMREX_LOOP_3D(ba[ibox], i, j, k,
+            {
+                x(i,j,k) = L.x[id++];
+            });
+        }
+
+        status[0] = ret;
+        status[1] = it;
+    }
+
+    ParallelDescriptor::Bcast(status, 2, ParallelContext::global_to_local_rank(m_root),
+                              ParallelContext::CommunicatorSub());
+    iter = status[1];
+
+    sol.ParallelCopy(root_sol, 0, 0, 1);
+
+    return status[0];
+}
+
+}
@@ -3,6 +3,10 @@
 #include <AMReX_MLLinOp_K.H>
 #include <AMReX_MultiFabUtil.H>
 
+#ifdef AMREX_USE_EB
+#include <AMReX_EBCutCellData.H>
+#endif
+
 #ifndef BL_NO_FORT
 #include <AMReX_MLLinOp_F.H>
 #endif
@@ -363,6 +367,54 @@ MLCellLinOp::smooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
     }
 }
 
+bool
+MLCellLinOp::smoothResRestrict (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
+                                MultiFab& crse_res, bool skip_fillboundary) const
+{
+    // The fused kernels sweep each tile sequentially, so they are only
+    // used on the CPU, and they require plain 2x coarsening onto the same
+    // DistributionMapping (i.e., no agglomeration or consolidation).
+    if (AMREX_SPACEDIM == 1 || Gpu::inLaunchRegion()
+        || !supportsFusedSmoothResRestrict(amrlev, mglev)) {
+        return false;
+    }
+    const IntVect ratio = (amrlev > 0) ? IntVect(2) : mg_coarsen_ratio_vec[mglev];
+    if (ratio != IntVect(2)
+        || crse_res.DistributionMap() != sol.DistributionMap()
+        || crse_res.boxArray() != amrex::coarsen(sol.boxArray(), 2)) {
+        return false;
+    }
+
+    BL_PROFILE("MLCellLinOp::smoothResRestrict()");
+
+    applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution,
+            nullptr, skip_fillboundary);
+#ifdef AMREX_SOFT_PERF_COUNTERS
+    perf_counters.smooth(sol);
+#endif
+    Fsmooth(amrlev, mglev, sol, rhs, 0);
+
+    applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution);
+#ifdef AMREX_SOFT_PERF_COUNTERS
+    perf_counters.smooth(sol);
+    perf_counters.restrict(crse_res);
+#endif
+    FsmoothResRestrict(amrlev, mglev, sol, rhs, crse_res);
+
+    applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Correction);
+    FresRestrictTileBndry(amrlev, mglev, sol, rhs, crse_res);
+
+    return true;
+}
+
+MFItInfo
+MLCellLinOp::fusedTileInfo () noexcept
+{
+    IntVect tile_size(1024000);
+    tile_size[AMREX_SPACEDIM-1] = 32; // even, so that tiles can be coarsened
+    return MFItInfo().EnableTiling(tile_size).SetDynamic(true);
+}
+
 void
 MLCellLinOp::updateSolBC (int amrlev, const MultiFab& crse_bcdata) const
 {
@@ -847,8 +899,6 @@ MLCellLinOp::prepareForSolve ()
             auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
             const FabArray<EBCellFlagFab>* flags =
                 (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
-            auto area = (factory) ? factory->getAreaFrac()
-                : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
 #endif
 
             MFItInfo mfi_info;
@@ -866,6 +916,10 @@ MLCellLinOp::prepareForSolve ()
 
 #ifdef AMREX_USE_EB
                 auto fabtyp = (flags) ? (*flags)[mfi].getType(vbx) : FabType::regular;
+                std::unique_ptr<EBCutCellFab> cutfab;
+                if (fabtyp == FabType::singlevalued) {
+                    cutfab = std::make_unique<EBCutCellFab>(*factory, mfi, amrex::grow(vbx,1));
+                }
 #endif
 
 #ifdef AMREX_USE_GPU
@@ -891,9 +945,9 @@ MLCellLinOp::prepareForSolve ()
 #ifdef AMREX_USE_EB
                     if (fabtyp == FabType::singlevalued) {
                         GpuArray<Array4<Real const>,AMREX_SPACEDIM> ap
-                            {AMREX_D_DECL(area[0]->const_array(mfi),
-                                          area[1]->const_array(mfi),
-                                          area[2]->const_array(mfi))};
+                            {AMREX_D_DECL(cutfab->areaFrac(0),
+                                          cutfab->areaFrac(1),
+                                          cutfab->areaFrac(2))};
                         amrex::ParallelFor(Gpu::KernelInfo().setFusible(true), nthreads,
                         [=] AMREX_GPU_DEVICE (int tid) noexcept
                         {
@@ -1067,7 +1121,7 @@ MLCellLinOp::prepareForSolve ()
                             const Real bclhi = bdlv[icomp][ohi];
 #ifdef AMREX_USE_EB
                             if (fabtyp == FabType::singlevalued) {
-                                Array4<Real const> const& ap = area[idim]->const_array(mfi);
+                                Array4<Real const> const& ap = cutfab->areaFrac(idim);
                                 if (idim == 0) {
                                     mllinop_comp_interp_coef0_x_eb
                                         (0, blo, blen, flo, mlo, ap, bctlo, bcllo,
@@ -4,6 +4,8 @@
 #include <AMReX_MultiFabUtil.H>
 #include <AMReX_EBMultiFabUtil.H>
 #include <AMReX_EBFArrayBox.H>
+#include <AMReX_EBCutCellData.H>
+#include <AMReX_ParmParse.H>
 
 #include <AMReX_MLABecLap_K.H>
 #include <AMReX_MLEBABecLap_K.H>
@@ -34,10 +36,12 @@ MLEBABecLap::MLEBABecLap (const Vector<Geometry>& a_geom,
 std::unique_ptr<FabFactory<FArrayBox> >
 MLEBABecLap::makeFactory (int amrlev, int mglev) const
 {
+    auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][0].get());
     return makeEBFabFactory(m_geom[amrlev][mglev],
                             m_grids[amrlev][mglev],
                             m_dmap[amrlev][mglev],
-                            {1,1,1}, EBSupport::full);
+                            {1,1,1}, EBSupport::full,
+                            (factory) ? factory->cutCellStorage() : EBCutCellStorage::dense);
 }
 
 void
@@ -58,17 +62,29 @@ MLEBABecLap::define (const Vector<Geometry>& a_geom,
 
     const int ncomp = getNComp();
 
+    {
+        ParmParse pp("mlebabeclap");
+        Vector<int> tilesize(AMREX_SPACEDIM);
+        if (pp.queryarr("sub_tile_size", tilesize, 0, AMREX_SPACEDIM)) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_sub_tile_size[idim] = tilesize[idim];
+            }
+        }
+    }
+
     m_a_coeffs.resize(m_num_amr_levels);
     m_b_coeffs.resize(m_num_amr_levels);
     m_cc_mask.resize(m_num_amr_levels);
     m_eb_phi.resize(m_num_amr_levels);
     m_eb_b_coeffs.resize(m_num_amr_levels);
+    m_sub_tiles.resize(m_num_amr_levels);
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
     {
         m_a_coeffs[amrlev].resize(m_num_mg_levels[amrlev]);
         m_b_coeffs[amrlev].resize(m_num_mg_levels[amrlev]);
         m_cc_mask[amrlev].resize(m_num_mg_levels[amrlev]);
         m_eb_b_coeffs[amrlev].resize(m_num_mg_levels[amrlev]);
+        m_sub_tiles[amrlev].resize(m_num_mg_levels[amrlev]);
         for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev)
         {
             m_a_coeffs[amrlev][mglev].define(m_grids[amrlev][mglev],
@@ -89,6 +105,8 @@ MLEBABecLap::define (const Vector<Geometry>& a_geom,
             m_cc_mask[amrlev][mglev].BuildMask(m_geom[amrlev][mglev].Domain(),
                                                m_geom[amrlev][mglev].periodicity(),
                                                1, 0, 0, 1);
+
+            buildSubTiles(amrlev, mglev);
         }
     }
 
@@ -99,6 +117,43 @@ MLEBABecLap::define (const Vector<Geometry>& a_geom,
 MLEBABecLap::~MLEBABecLap ()
 {}
 
+void
+MLEBABecLap::buildSubTiles (int amrlev, int mglev)
+{
+    auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
+    if (factory == nullptr || !m_sub_tile_size.allGT(IntVect::TheZeroVector()) || Gpu::inLaunchRegion()) return;
+
+    const auto& flags = factory->getMultiEBCellFlagFab();
+    m_sub_tiles[amrlev][mglev].reset(new LayoutData<SubTiles>(m_grids[amrlev][mglev],
+                                                              m_dmap[amrlev][mglev]));
+    auto& sub_tiles = *m_sub_tiles[amrlev][mglev];
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx = mfi.validbox();
+        if (flags[mfi].getType(vbx) != FabType::singlevalued) continue;
+
+        Array4<EBCellFlag const> const& flag = flags.const_array(mfi);
+        const BoxList tilelist(vbx, m_sub_tile_size);
+        for (const Box& tbx : tilelist)
+        {
+            bool regular = true;
+            amrex::LoopOnCpu(tbx, [&] (int i, int j, int k) noexcept
+            {
+                regular = regular && flag(i,j,k).isRegular();
+            });
+            if (regular) {
+                sub_tiles[mfi].regular.push_back(tbx);
+            } else {
+                sub_tiles[mfi].cut.push_back(tbx);
+            }
+        }
+    }
+}
+
 void
 MLEBABecLap::setPhiOnCentroid ()
 {
@@ -689,13 +744,6 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
     const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    const MultiCutFab* barea = (factory) ? &(factory->getBndryArea()) : nullptr;
-    const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
-    const auto         ccent = (factory) ? &(factory->getCentroid()) : nullptr;
 
     const bool is_eb_dirichlet =  isEBDirichlet();
     const bool is_eb_inhomog = m_is_eb_inhomog;
@@ -755,15 +803,16 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
             Array4<int const> const& ccmfab = ccmask.const_array(mfi);
             Array4<EBCellFlag const> const& flagfab = flags->const_array(mfi);
             Array4<Real const> const& vfracfab = vfrac->const_array(mfi);
-            AMREX_D_TERM(Array4<Real const> const& apxfab = area[0]->const_array(mfi);,
-                         Array4<Real const> const& apyfab = area[1]->const_array(mfi);,
-                         Array4<Real const> const& apzfab = area[2]->const_array(mfi););
-            AMREX_D_TERM(Array4<Real const> const& fcxfab = fcent[0]->const_array(mfi);,
-                         Array4<Real const> const& fcyfab = fcent[1]->const_array(mfi);,
-                         Array4<Real const> const& fczfab = fcent[2]->const_array(mfi););
-            Array4<Real const> const& bafab = barea->const_array(mfi);
-            Array4<Real const> const& bcfab = bcent->const_array(mfi);
-            Array4<Real const> const& ccfab = ccent->const_array(mfi);
+            EBCutCellFab cutfab(*factory, mfi, amrex::grow(bx,2));
+            AMREX_D_TERM(Array4<Real const> const& apxfab = cutfab.areaFrac(0);,
+                         Array4<Real const> const& apyfab = cutfab.areaFrac(1);,
+                         Array4<Real const> const& apzfab = cutfab.areaFrac(2););
+            AMREX_D_TERM(Array4<Real const> const& fcxfab = cutfab.faceCent(0);,
+                         Array4<Real const> const& fcyfab = cutfab.faceCent(1);,
+                         Array4<Real const> const& fczfab = cutfab.faceCent(2););
+            Array4<Real const> const& bafab = cutfab.bndryArea();
+            Array4<Real const> const& bcfab = cutfab.bndryCent();
+            Array4<Real const> const& ccfab = cutfab.centroid();
             Array4<Real const> const& bebfab = (is_eb_dirichlet)
                 ? m_eb_b_coeffs[amrlev][mglev]->const_array(mfi) : foo;
             Array4<Real const> const& phiebfab = (is_eb_dirichlet && is_eb_inhomog)
@@ -774,6 +823,9 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
 
             bool treat_phi_as_on_centroid = ( phi_on_centroid && (mglev == 0) );
 
+            const SubTiles* sub_tiles = (m_sub_tiles[amrlev][mglev] && Gpu::notInLaunchRegion())
+                ? &((*m_sub_tiles[amrlev][mglev])[mfi]) : nullptr;
+
             if (treat_phi_as_on_centroid) {
                AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( bx, tbx,
                {
@@ -788,6 +840,29 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
                                      is_eb_dirichlet, is_eb_inhomog, dxinvarr,
                                      ascalar, bscalar, ncomp);
                });
+            } else if (sub_tiles) {
+               for (const Box& t : sub_tiles->regular) {
+                   const Box tbx = t & bx;
+                   if (tbx.ok()) {
+                       mlabeclap_adotx(tbx, yfab, xfab, afab,
+                                       AMREX_D_DECL(bxfab,byfab,bzfab),
+                                       dxinvarr, ascalar, bscalar, ncomp);
+                   }
+               }
+               for (const Box& t : sub_tiles->cut) {
+                   const Box tbx = t & bx;
+                   if (tbx.ok()) {
+                       mlebabeclap_adotx(tbx, yfab, xfab, afab, AMREX_D_DECL(bxfab,byfab,bzfab),
+                                         ccmfab, flagfab, vfracfab,
+                                         AMREX_D_DECL(apxfab,apyfab,apzfab),
+                                         AMREX_D_DECL(fcxfab,fcyfab,fczfab),
+                                         bafab, bcfab, bebfab,
+                                         is_eb_dirichlet,
+                                         phiebfab,
+                                         is_eb_inhomog, dxinvarr,
+                                         ascalar, bscalar, ncomp, beta_on_centroid, phi_on_centroid);
+                   }
+               }
             } else {
                AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( bx, tbx,
                {
@@ -853,12 +928,6 @@ MLEBABecLap::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
     const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    const MultiCutFab* barea = (factory) ? &(factory->getBndryArea()) : nullptr;
-    const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
 
     bool is_eb_dirichlet =  isEBDirichlet();
 
@@ -930,14 +999,15 @@ MLEBABecLap::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
             Array4<int const> const& ccmfab = ccmask.const_array(mfi);
             Array4<EBCellFlag const> const& flagfab = flags->const_array(mfi);
             Array4<Real const> const& vfracfab = vfrac->const_array(mfi);
-            AMREX_D_TERM(Array4<Real const> const& apxfab = area[0]->const_array(mfi);,
-                         Array4<Real const> const& apyfab = area[1]->const_array(mfi);,
-                         Array4<Real const> const& apzfab = area[2]->const_array(mfi););
-            AMREX_D_TERM(Array4<Real const> const& fcxfab = fcent[0]->const_array(mfi);,
-                         Array4<Real const> const& fcyfab = fcent[1]->const_array(mfi);,
-                         Array4<Real const> const& fczfab = fcent[2]->const_array(mfi););
-            Array4<Real const> const& bafab = barea->const_array(mfi);
-            Array4<Real const> const& bcfab = bcent->const_array(mfi);
+            EBCutCellFab cutfab(*factory, mfi, amrex::grow(vbx,2));
+            AMREX_D_TERM(Array4<Real const> const& apxfab = cutfab.areaFrac(0);,
+                         Array4<Real const> const& apyfab = cutfab.areaFrac(1);,
+                         Array4<Real const> const& apzfab = cutfab.areaFrac(2););
+            AMREX_D_TERM(Array4<Real const> const& fcxfab = cutfab.faceCent(0);,
+                         Array4<Real const> const& fcyfab = cutfab.faceCent(1);,
+                         Array4<Real const> const& fczfab = cutfab.faceCent(2););
+            Array4<Real const> const& bafab = cutfab.bndryArea();
+            Array4<Real const> const& bcfab = cutfab.bndryCent();
             Array4<Real const> const& bebfab = (is_eb_dirichlet)
                 ? m_eb_b_coeffs[amrlev][mglev]->const_array(mfi) : foo;
 
@@ -946,22 +1016,56 @@ MLEBABecLap::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
 
             if (phi_on_centroid) amrex::Abort("phi_on_centroid is still a WIP");
 
-            AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( vbx, thread_box,
+            const SubTiles* sub_tiles = (m_sub_tiles[amrlev][mglev] && Gpu::notInLaunchRegion())
+                ? &((*m_sub_tiles[amrlev][mglev])[mfi]) : nullptr;
+
+            if (sub_tiles)
             {
-                mlebabeclap_gsrb(thread_box, solnfab, rhsfab, alpha, afab,
-                                 AMREX_D_DECL(dhx, dhy, dhz),
-                                 AMREX_D_DECL(bxfab,byfab,bzfab),
-                                 AMREX_D_DECL(m0,m2,m4),
-                                 AMREX_D_DECL(m1,m3,m5),
-                                 AMREX_D_DECL(f0fab,f2fab,f4fab),
-                                 AMREX_D_DECL(f1fab,f3fab,f5fab),
-                                 ccmfab, flagfab, vfracfab,
-                                 AMREX_D_DECL(apxfab,apyfab,apzfab),
-                                 AMREX_D_DECL(fcxfab,fcyfab,fczfab),
-                                 bafab, bcfab, bebfab,
-                                 is_eb_dirichlet, beta_on_centroid, phi_on_centroid,
-                                 vbx, redblack, nc);
-            });
+                for (const Box& tbx : sub_tiles->regular) {
+                    abec_gsrb(tbx, solnfab, rhsfab, alpha, afab,
+                              AMREX_D_DECL(dhx, dhy, dhz),
+                              AMREX_D_DECL(bxfab, byfab, bzfab),
+                              AMREX_D_DECL(m0,m2,m4),
+                              AMREX_D_DECL(m1,m3,m5),
+                              AMREX_D_DECL(f0fab,f2fab,f4fab),
+                              AMREX_D_DECL(f1fab,f3fab,f5fab),
+                              vbx, redblack, nc);
+                }
+                for (const Box& tbx : sub_tiles->cut) {
+                    mlebabeclap_gsrb(tbx, solnfab, rhsfab, alpha, afab,
+                                     AMREX_D_DECL(dhx, dhy, dhz),
+                                     AMREX_D_DECL(bxfab,byfab,bzfab),
+                                     AMREX_D_DECL(m0,m2,m4),
+                                     AMREX_D_DECL(m1,m3,m5),
+                                     AMREX_D_DECL(f0fab,f2fab,f4fab),
+                                     AMREX_D_DECL(f1fab,f3fab,f5fab),
+                                     ccmfab, flagfab, vfracfab,
+                                     AMREX_D_DECL(apxfab,apyfab,apzfab),
+                                     AMREX_D_DECL(fcxfab,fcyfab,fczfab),
+                                     bafab, bcfab, bebfab,
+                                     is_eb_dirichlet, beta_on_centroid, phi_on_centroid,
+                                     vbx, redblack, nc);
+                }
+            }
+            else
+            {
+                AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( vbx, thread_box,
+                {
+                    mlebabeclap_gsrb(thread_box, solnfab, rhsfab, alpha, afab,
+                                     AMREX_D_DECL(dhx, dhy, dhz),
+                                     AMREX_D_DECL(bxfab,byfab,bzfab),
+                                     AMREX_D_DECL(m0,m2,m4),
+                                     AMREX_D_DECL(m1,m3,m5),
+                                     AMREX_D_DECL(f0fab,f2fab,f4fab),
+                                     AMREX_D_DECL(f1fab,f3fab,f5fab),
+                                     ccmfab, flagfab, vfracfab,
+                                     AMREX_D_DECL(apxfab,apyfab,apzfab),
+                                     AMREX_D_DECL(fcxfab,fcyfab,fczfab),
+                                     bafab, bcfab, bebfab,
+                                     is_eb_dirichlet, beta_on_centroid, phi_on_centroid,
+                                     vbx, redblack, nc);
+                });
+            }
         }
     }
 }
@@ -1013,14 +1117,13 @@ MLEBABecLap::FFlux (int amrlev, const MFIter& mfi, const Array<FArrayBox*,AMREX_
                                Array<FArrayBox const*,AMREX_SPACEDIM>{AMREX_D_DECL(&bx,&by,&bz)},
                                flux, sol, face_only, ncomp);
     } else if (compute_flux_at_centroid) {
-        const auto& area = factory->getAreaFrac();
-        const auto& fcent = factory->getFaceCent();
-        AMREX_D_TERM(Array4<Real const> const& apx = area[0]->const_array(mfi);,
-                     Array4<Real const> const& apy = area[1]->const_array(mfi);,
-                     Array4<Real const> const& apz = area[2]->const_array(mfi););
-        AMREX_D_TERM(Array4<Real const> const& fcx = fcent[0]->const_array(mfi);,
-                     Array4<Real const> const& fcy = fcent[1]->const_array(mfi);,
-                     Array4<Real const> const& fcz = fcent[2]->const_array(mfi););
+        EBCutCellFab cutfab(*factory, mfi, amrex::grow(box,2));
+        AMREX_D_TERM(Array4<Real const> const& apx = cutfab.areaFrac(0);,
+                     Array4<Real const> const& apy = cutfab.areaFrac(1);,
+                     Array4<Real const> const& apz = cutfab.areaFrac(2););
+        AMREX_D_TERM(Array4<Real const> const& fcx = cutfab.faceCent(0);,
+                     Array4<Real const> const& fcy = cutfab.faceCent(1);,
+                     Array4<Real const> const& fcz = cutfab.faceCent(2););
         Array4<Real const> const& phi = sol.const_array();
         AMREX_D_TERM(Array4<Real const> const& bxcoef = bx.const_array();,
                      Array4<Real const> const& bycoef = by.const_array();,
@@ -1053,10 +1156,10 @@ MLEBABecLap::FFlux (int amrlev, const MFIter& mfi, const Array<FArrayBox*,AMREX_
             }
         );
     } else {
-        const auto& area = factory->getAreaFrac();
-        AMREX_D_TERM(Array4<Real const> const& apx = area[0]->const_array(mfi);,
-                     Array4<Real const> const& apy = area[1]->const_array(mfi);,
-                     Array4<Real const> const& apz = area[2]->const_array(mfi););
+        EBCutCellFab cutfab(*factory, mfi, amrex::grow(box,2));
+        AMREX_D_TERM(Array4<Real const> const& apx = cutfab.areaFrac(0);,
+                     Array4<Real const> const& apy = cutfab.areaFrac(1);,
+                     Array4<Real const> const& apz = cutfab.areaFrac(2););
         Array4<Real const> const& phi = sol.const_array();
         AMREX_D_TERM(Array4<Real const> const& bxcoef = bx.const_array();,
                      Array4<Real const> const& bycoef = by.const_array();,
@@ -1101,10 +1204,6 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
 
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac() :
-        Array<const MultiCutFab*, AMREX_SPACEDIM>{AMREX_D_DECL(nullptr, nullptr, nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent():
-        Array<const MultiCutFab*, AMREX_SPACEDIM>{AMREX_D_DECL(nullptr, nullptr, nullptr)};
 
     MFItInfo mfi_info;
     if (Gpu::notInLaunchRegion()) mfi_info.EnableTiling().SetDynamic(true);
@@ -1153,12 +1252,13 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
             });
 #endif
         } else if (compute_grad_at_centroid) {
-            AMREX_D_TERM(Array4<Real const> const& apx = area[0]->const_array(mfi);,
-                         Array4<Real const> const& apy = area[1]->const_array(mfi);,
-                         Array4<Real const> const& apz = area[2]->const_array(mfi););
-            AMREX_D_TERM(Array4<Real const> const& fcx = fcent[0]->const_array(mfi);,
-                         Array4<Real const> const& fcy = fcent[1]->const_array(mfi);,
-                         Array4<Real const> const& fcz = fcent[2]->const_array(mfi););
+            EBCutCellFab cutfab(*factory, mfi, amrex::grow(box,2));
+            AMREX_D_TERM(Array4<Real const> const& apx = cutfab.areaFrac(0);,
+                         Array4<Real const> const& apy = cutfab.areaFrac(1);,
+                         Array4<Real const> const& apz = cutfab.areaFrac(2););
+            AMREX_D_TERM(Array4<Real const> const& fcx = cutfab.faceCent(0);,
+                         Array4<Real const> const& fcy = cutfab.faceCent(1);,
+                         Array4<Real const> const& fcz = cutfab.faceCent(2););
             Array4<int const> const& msk = ccmask.const_array(mfi);
 
             bool phi_on_centroid = (m_phi_loc == Location::CellCentroid);
@@ -1180,10 +1280,10 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
                 }
             );
         } else {
-
-            AMREX_D_TERM(Array4<Real const> const& ax = area[0]->const_array(mfi);,
-                         Array4<Real const> const& ay = area[1]->const_array(mfi);,
-                         Array4<Real const> const& az = area[2]->const_array(mfi););
+            EBCutCellFab cutfab(*factory, mfi, amrex::grow(box,2));
+            AMREX_D_TERM(Array4<Real const> const& ax = cutfab.areaFrac(0);,
+                         Array4<Real const> const& ay = cutfab.areaFrac(1);,
+                         Array4<Real const> const& az = cutfab.areaFrac(2););
 
             AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_phi_loc == Location::CellCenter,
              "If computing the gradient at face centers we assume phi at cell centers");
@@ -1223,12 +1323,6 @@ MLEBABecLap::normalize (int amrlev, int mglev, MultiFab& mf) const
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
     const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    const MultiCutFab* barea = (factory) ? &(factory->getBndryArea()) : nullptr;
-    const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
 
     bool is_eb_dirichlet =  isEBDirichlet();
 
@@ -1269,14 +1363,15 @@ MLEBABecLap::normalize (int amrlev, int mglev, MultiFab& mf) const
             Array4<int const> const& ccmfab = ccmask.const_array(mfi);
             Array4<EBCellFlag const> const& flagfab = flags->const_array(mfi);
             Array4<Real const> const& vfracfab = vfrac->const_array(mfi);
-            AMREX_D_TERM(Array4<Real const> const& apxfab = area[0]->const_array(mfi);,
-                         Array4<Real const> const& apyfab = area[1]->const_array(mfi);,
-                         Array4<Real const> const& apzfab = area[2]->const_array(mfi););
-            AMREX_D_TERM(Array4<Real const> const& fcxfab = fcent[0]->const_array(mfi);,
-                         Array4<Real const> const& fcyfab = fcent[1]->const_array(mfi);,
-                         Array4<Real const> const& fczfab = fcent[2]->const_array(mfi););
-            Array4<Real const> const& bafab = barea->const_array(mfi);
-            Array4<Real const> const& bcfab = bcent->const_array(mfi);
+            EBCutCellFab cutfab(*factory, mfi, amrex::grow(bx,2));
+            AMREX_D_TERM(Array4<Real const> const& apxfab = cutfab.areaFrac(0);,
+                         Array4<Real const> const& apyfab = cutfab.areaFrac(1);,
+                         Array4<Real const> const& apzfab = cutfab.areaFrac(2););
+            AMREX_D_TERM(Array4<Real const> const& fcxfab = cutfab.faceCent(0);,
+                         Array4<Real const> const& fcyfab = cutfab.faceCent(1);,
+                         Array4<Real const> const& fczfab = cutfab.faceCent(2););
+            Array4<Real const> const& bafab = cutfab.bndryArea();
+            Array4<Real const> const& bcfab = cutfab.bndryCent();
 
             bool beta_on_centroid = (m_beta_loc == Location::FaceCentroid);
 
@@ -1393,8 +1488,6 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
 
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
 
     FArrayBox foofab(Box::TheUnitBox(),ncomp);
     const auto& foo = foofab.array();
@@ -1416,6 +1509,11 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
             const auto & bdlv = bcondloc.bndryLocs(mfi);
             const auto & bdcv = bcondloc.bndryConds(mfi);
 
+            std::unique_ptr<EBCutCellFab> cutfab;
+            if (fabtyp != FabType::regular) {
+                cutfab = std::make_unique<EBCutCellFab>(*factory, mfi, amrex::grow(vbx,2));
+            }
+
             for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
             {
                 const Orientation olo(idim,Orientation::low);
@@ -1478,7 +1576,7 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
                     }
                     else // irregular
                     {
-                        const auto& ap = area[idim]->const_array(mfi);
+                        const auto& ap = cutfab->areaFrac(idim);
                         const auto& mask = ccmask.const_array(mfi);
                         if (idim == 0) {
                             AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
@@ -1588,11 +1686,6 @@ MLEBABecLap::getEBFluxes (const Vector<MultiFab*>& a_flux, const Vector<MultiFab
             auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
             const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
             const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-            auto area = (factory) ? factory->getAreaFrac()
-                : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-
-            const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
-
             const bool is_eb_inhomog = m_is_eb_inhomog;
 
             Array4<Real const> foo;
@@ -1618,10 +1711,11 @@ MLEBABecLap::getEBFluxes (const Vector<MultiFab*>& a_flux, const Vector<MultiFab
                 } else {
                     Array4<EBCellFlag const> const& flagfab = flags->const_array(mfi);
                     Array4<Real const> const& vfracfab = vfrac->const_array(mfi);
-                    AMREX_D_TERM(Array4<Real const> const& apxfab = area[0]->const_array(mfi);,
-                                 Array4<Real const> const& apyfab = area[1]->const_array(mfi);,
-                                 Array4<Real const> const& apzfab = area[2]->const_array(mfi););
-                    Array4<Real const> const& bcfab = bcent->const_array(mfi);
+                    EBCutCellFab cutfab(*factory, mfi, amrex::grow(bx,2));
+                    AMREX_D_TERM(Array4<Real const> const& apxfab = cutfab.areaFrac(0);,
+                                 Array4<Real const> const& apyfab = cutfab.areaFrac(1);,
+                                 Array4<Real const> const& apzfab = cutfab.areaFrac(2););
+                    Array4<Real const> const& bcfab = cutfab.bndryCent();
                     Array4<Real const> const& bebfab = (is_eb_dirichlet)
                         ? m_eb_b_coeffs[amrlev][mglev]->const_array(mfi) : foo;
                     Array4<Real const> const& phiebfab = (is_eb_dirichlet && m_is_eb_inhomog)
@@ -0,0 +1,369 @@
+
+#include <AMReX_MLFFTSolver.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelContext.H>
+
+#include <cmath>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+
+using Complex = MLFFTSolver::Complex;
+using Plan = MLFFTSolver::Plan;
+
+int
+smallest_factor (int n)
+{
+    for (int p = 2; p*p <= n; ++p) {
+        if (n % p == 0) return p;
+    }
+    return n;
+}
+
+Plan
+make_plan (int n)
+{
+    Plan plan;
+    plan.n = n;
+    plan.twiddle.resize(n);
+    const double fac = -2.0*3.14159265358979323846/static_cast<double>(n);
+    for (int j = 0; j < n; ++j) {
+        plan.twiddle[j] = Complex(static_cast<Real>(std::cos(fac*j)),
+                                  static_cast<Real>(std::sin(fac*j)));
+    }
+    for (int m = n; m > 1; ) {
+        const int p = smallest_factor(m);
+        plan.max_factor = std::max(plan.max_factor, p);
+        m /= p;
+    }
+    return plan;
+}
+
+// Mixed-radix decimation-in-time DFT of the n values in[0], in[s], in[2s],
+// ..., written contiguously to out.  n must divide plan.n.  scratch must
+// hold at least plan.max_factor values.
+void
+fft_rec (Complex* out, Complex const* in, int n, int s, Plan const& plan, Complex* scratch)
+{
+    if (n == 1) {
+        out[0] = in[0];
+        return;
+    }
+
+    const int p = smallest_factor(n);
+    const int m = n/p;
+    for (int q = 0; q < p; ++q) {
+        fft_rec(out+q*m, in+q*s, m, s*p, plan, scratch);
+    }
+
+    const int wstride = plan.n/n;
+    Complex const* w = plan.twiddle.data();
+    for (int k = 0; k < m; ++k) {
+        for (int q = 0; q < p; ++q) {
+            scratch[q] = out[q*m+k];
+        }
+        for (int t = 0; t < p; ++t) {
+            const int kk = k + t*m;
+            Complex sum = scratch[0];
+            for (int q = 1; q < p; ++q) {
+                sum += scratch[q] * w[((q*kk) % n) * wstride];
+            }
+            out[kk] = sum;
+        }
+    }
+}
+
+// In-place transform of the line a[0], a[stride], ... of length plan.n.
+// The inverse transform is not normalized.
+void
+fft_line (Complex* a, int stride, Plan const& plan, bool inverse,
+          Vector<Complex>& in, Vector<Complex>& out, Vector<Complex>& scratch)
+{
+    const int n = plan.n;
+    for (int i = 0; i < n; ++i) {
+        in[i] = inverse ? std::conj(a[i*stride]) : a[i*stride];
+    }
+    fft_rec(out.data(), in.data(), n, 1, plan, scratch.data());
+    for (int i = 0; i < n; ++i) {
+        a[i*stride] = inverse ? std::conj(out[i]) : out[i];
+    }
+}
+
+// Map index e of the extended domain to the index of the unknown it
+// mirrors and the sign of the reflection.  The extended domain consists of
+// segments of length n that alternate between the original data and its
+// reflection, the reflection at the high (low) end of the original data
+// having sign shi (slo).  For nodal data with boundary nodes at 0 and n,
+// offset is 0; for cell-centered data it is 1.
+void
+unfold (int e, int n, int offset, int slo, int shi, int& i, int& sign)
+{
+    const int q = e / n;
+    const int r = e - q*n;
+    i = (q % 2 == 0) ? r : n - offset - r;
+    sign = 1;
+    for (int iq = 1; iq <= q; ++iq) {
+        sign *= (iq % 2 == 1) ? shi : slo;
+    }
+}
+
+}
+
+MLFFTSolver::MLFFTSolver (MLLinOp& a_lp)
+    : Lp(a_lp), amrlev(0), mglev(a_lp.NMGLevels(0)-1)
+{}
+
+MLFFTSolver::~MLFFTSolver () {}
+
+bool
+MLFFTSolver::isSupported (const MLLinOp& a_lp)
+{
+    Real scale;
+    if (a_lp.getNComp() != 1 || !a_lp.isBottomConstantLaplacian(scale)) return false;
+
+    const int mglev = a_lp.NMGLevels(0)-1;
+    const Geometry& geom = a_lp.Geom(0, mglev);
+    if (a_lp.m_grids[0][mglev].numPts() != geom.Domain().numPts()) return false;
+
+    const bool cell = a_lp.isCellCentered();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (geom.isPeriodic(idim)) continue;
+        for (auto bc : {a_lp.m_lobc[0][idim], a_lp.m_hibc[0][idim]}) {
+            bool ok = (bc == LinOpBCType::Dirichlet || bc == LinOpBCType::Neumann);
+            if (cell) {
+                ok = ok || bc == LinOpBCType::reflect_odd || bc == LinOpBCType::inhomogNeumann;
+            } else {
+                ok = ok || bc == LinOpBCType::inflow;
+            }
+            if (!ok) return false;
+        }
+    }
+    return true;
+}
+
+void
+MLFFTSolver::setup (const MultiFab& sol)
+{
+    BL_PROFILE("MLFFTSolver::setup()");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(isSupported(Lp),
+        "MLFFTSolver: bottom level must be a constant coefficient Laplacian covering the domain"
+        " with periodic, Dirichlet or Neumann boundaries");
+
+    Real scale = 0.0;
+    Lp.isBottomConstantLaplacian(scale);
+
+    const bool cell = Lp.isCellCentered();
+    const Geometry& geom = Lp.Geom(amrlev, mglev);
+    const Box& domain = geom.Domain();
+    m_box = cell ? domain : amrex::surroundingNodes(domain);
+    m_root = sol.DistributionMap()[0];
+
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        const int ncell = domain.length(idim);
+        m_periodic[idim] = geom.isPeriodic(idim);
+        if (m_periodic[idim]) {
+            m_n[idim] = ncell;
+            m_next[idim] = ncell;
+        } else {
+            auto sign = [] (LinOpBCType bc) {
+                return (bc == LinOpBCType::Dirichlet || bc == LinOpBCType::reflect_odd) ? -1 : 1;
+            };
+            m_slo[idim] = sign(Lp.m_lobc[0][idim]);
+            m_shi[idim] = sign(Lp.m_hibc[0][idim]);
+            m_n[idim] = cell ? ncell : ncell+1;
+            m_next[idim] = (m_slo[idim] == m_shi[idim]) ? 2*ncell : 4*ncell;
+        }
+    }
+
+    for (int idim = 0; idim < 3; ++idim) {
+        m_plan[idim] = make_plan(m_next[idim]);
+    }
+
+    if (ParallelDescriptor::MyProc() != m_root) {
+        m_setup = true;
+        return;
+    }
+
+    // Symbols of the second difference, K, and of the mass matrix of the
+    // linear finite element, M, in each direction.  The cell-centered
+    // operator is sum_d K_d, and the nodal one is sum_d K_d prod_{d'!=d} M_d'.
+    Array<Vector<Real>,3> K, M;
+    const auto dxinv = geom.InvCellSizeArray();
+    for (int idim = 0; idim < 3; ++idim) {
+        const int n = m_next[idim];
+        K[idim].resize(n, 0.0);
+        M[idim].resize(n, 1.0);
+        if (idim >= AMREX_SPACEDIM) continue;
+        const double dxi2 = static_cast<double>(dxinv[idim])*dxinv[idim];
+        for (int k = 0; k < n; ++k) {
+            const double c = std::cos(2.0*3.14159265358979323846*k/static_cast<double>(n));
+            K[idim][k] = static_cast<Real>((2.0*c - 2.0)*dxi2);
+            M[idim][k] = static_cast<Real>((2.0 + c)/3.0);
+        }
+    }
+
+    const Long npts = static_cast<Long>(m_next[0])*m_next[1]*m_next[2];
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(npts < static_cast<Long>(std::numeric_limits<int>::max()),
+                                     "MLFFTSolver: bottom level too large");
+    m_eigen.resize(npts);
+    m_data.resize(npts);
+    for (int k = 0; k < m_next[2]; ++k) {
+    for (int j = 0; j < m_next[1]; ++j) {
+    for (int i = 0; i < m_next[0]; ++i) {
+        Real lambda;
+        if (cell) {
+            lambda = K[0][i] + K[1][j] + K[2][k];
+        } else {
+            lambda = K[0][i]*M[1][j]*M[2][k]
+                +    M[0][i]*K[1][j]*M[2][k]
+                +    M[0][i]*M[1][j]*K[2][k];
+        }
+        m_eigen[i+m_next[0]*(j+m_next[1]*k)] = scale*lambda;
+    }}}
+
+    m_setup = true;
+}
+
+void
+MLFFTSolver::directSolve (MultiFab& sol, const MultiFab& rhs)
+{
+    BL_PROFILE("MLFFTSolver::directSolve()");
+
+    const BoxArray root_ba(m_box);
+    const DistributionMapping root_dm(Vector<int>{m_root});
+    MultiFab root_rhs(root_ba, root_dm, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    MultiFab root_sol(root_ba, root_dm, 1, 0, MFInfo().SetArena(The_Pinned_Arena()));
+    root_rhs.ParallelCopy(rhs, 0, 0, 1);
+
+    if (ParallelDescriptor::MyProc() == m_root)
+    {
+        const int offset = Lp.isCellCentered() ? 1 : 0;
+        const auto lo = amrex::lbound(m_box);
+        const int nx = m_next[0], ny = m_next[1], nz = m_next[2];
+
+        auto const& b = root_rhs.const_array(0);
+        for (int ek = 0; ek < nz; ++ek) {
+        for (int ej = 0; ej < ny; ++ej) {
+        for (int ei = 0; ei < nx; ++ei) {
+            GpuArray<int,3> idx {{0,0,0}};
+            int sign = 1;
+            const int e[3] = {ei, ej, ek};
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (m_periodic[idim]) {
+                    idx[idim] = e[idim];
+                } else {
+                    int s;
+                    unfold(e[idim], m_n[idim]-1+offset, offset, m_slo[idim], m_shi[idim], idx[idim], s);
+                    // Dirichlet nodes are not unknowns.
+                    if (offset == 0 && ((idx[idim] == 0 && m_slo[idim] < 0) ||
+                                        (idx[idim] == m_n[idim]-1 && m_shi[idim] < 0))) {
+                        s = 0;
+                    }
+                    sign *= s;
+                }
+            }
+            m_data[ei+nx*(ej+ny*ek)] = Complex(sign*b(lo.x+idx[0],lo.y+idx[1],lo.z+idx[2]), 0.0);
+        }}}
+
+        const int nmax = std::max({nx,ny,nz});
+        const int fmax = std::max({m_plan[0].max_factor,m_plan[1].max_factor,m_plan[2].max_factor});
+        Vector<Complex> lin(nmax), lout(nmax), scratch(fmax);
+
+        for (bool inverse : {false, true})
+        {
+            if (inverse) {
+                for (Long i = 0, N = m_data.size(); i < N; ++i) {
+                    m_data[i] = (m_eigen[i] != Real(0.0)) ? m_data[i]/m_eigen[i] : Complex(0.0,0.0);
+                }
+            }
+            if (nx > 1) {
+                for (int k = 0; k < nz; ++k) {
+                for (int j = 0; j < ny; ++j) {
+                    fft_line(m_data.data()+nx*(j+ny*k), 1, m_plan[0], inverse, lin, lout, scratch);
+                }}
+            }
+            if (ny > 1) {
+                for (int k = 0; k < nz; ++k) {
+                for (int i = 0; i < nx; ++i) {
+                    fft_line(m_data.data()+i+nx*ny*k, nx, m_plan[1], inverse, lin, lout, scratch);
+                }}
+            }
+            if (nz > 1) {
+                for (int j = 0; j < ny; ++j) {
+                for (int i = 0; i < nx; ++i) {
+                    fft_line(m_data.data()+i+nx*j, nx*ny, m_plan[2], inverse, lin, lout, scratch);
+                }}
+            }
+        }
+
+        const Real fac = Real(1.0)/static_cast<Real>(m_data.size());
+        auto const& x = root_sol.array(0);
+        const auto hi = amrex::ubound(m_box);
+        for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+        for (int i = lo.x; i <= hi.x; ++i) {
+            // The high end nodes of periodic directions map back to the low end.
+            const int ei = (i-lo.x < nx) ? i-lo.x : 0;
+            const int ej = (j-lo.y < ny) ? j-lo.y : 0;
+            const int ek = (k-lo.z < nz) ? k-lo.z : 0;
+            x(i,j,k) = fac * m_data[ei+nx*(ej+ny*ek)].real();
+        }}}
+    }
+
+    sol.ParallelCopy(root_sol, 0, 0, 1);
+}
+
+int
+MLFFTSolver::solve (MultiFab& sol, const MultiFab& rhs, Real eps_rel, Real eps_abs)
+{
+    BL_PROFILE("MLFFTSolver::solve()");
+
+    if (!m_setup) { setup(sol); }
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = *Lp.Factory(amrlev, mglev);
+
+    MultiFab r(ba, dm, 1, 0, MFInfo(), factory);
+    MultiFab e(ba, dm, 1, sol.nGrow(), MFInfo(), factory);
+    MultiFab::Copy(r, rhs, 0, 0, 1, 0);
+    sol.setVal(0.0);
+
+    Real bnorm = rhs.norm0(0, 0, true);
+    ParallelAllReduce::Max(bnorm, Lp.BottomCommunicator());
+    const Real target = std::max(eps_rel*bnorm, eps_abs);
+
+    Real rnorm = bnorm;
+    int ret = (rnorm <= target) ? 0 : 2;
+    int it = 0;
+    while (ret != 0 && it < maxiter)
+    {
+        ++it;
+        directSolve(e, r);
+        MultiFab::Add(sol, e, 0, 0, 1, 0);
+
+        Lp.apply(amrlev, mglev, r, sol, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        MultiFab::Xpay(r, Real(-1.0), rhs, 0, 0, 1, 0);
+
+        rnorm = r.norm0(0, 0, true);
+        ParallelAllReduce::Max(rnorm, Lp.BottomCommunicator());
+        if (verbose > 1) {
+            amrex::Print() << "MLFFTSolver: Iteration " << it << " rnorm " << rnorm << "\n";
+        }
+        if (rnorm <= target) ret = 0;
+    }
+
+    if (verbose > 0) {
+        amrex::Print() << "MLFFTSolver: Final iter " << it
+                       << " resid " << rnorm << " target " << target << "\n";
+    }
+
+    iter = it;
+    return ret;
+}
+
+}
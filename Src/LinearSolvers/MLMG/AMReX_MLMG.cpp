@@ -62,7 +62,16 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
         bottom_solver = linop.getDefaultBottomSolver();
     }
 
-    if (bottom_solver == BottomSolver::hypre || bottom_solver == BottomSolver::petsc) {
+    if (bottom_solver == BottomSolver::fft && !MLFFTSolver::isSupported(linop)) {
+        if (verbose > 0) {
+            amrex::Print() << "MLMG: BottomSolver::fft is not supported by this problem,"
+                           << " switching to bicgstab\n";
+        }
+        bottom_solver = BottomSolver::bicgstab;
+    }
+
+    if (bottom_solver == BottomSolver::hypre || bottom_solver == BottomSolver::petsc ||
+        bottom_solver == BottomSolver::amg) {
         int mo = linop.getMaxOrder();
         if (a_sol[0]->hasEBFabFactory()) {
             linop.setMaxOrder(2);
@@ -75,6 +84,10 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
 
     auto solve_start_time = amrex::second();
 
+    if (m_hist_max > 0 && !is_nsolve) {
+        makeInitialGuessFromHistory(a_sol, a_rhs);
+    }
+
     Real& composite_norminf = m_final_resnorm0;
 
     m_niters_cg.clear();
@@ -215,11 +228,197 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
         }
     }
 
+    if (m_hist_max > 0 && !is_nsolve) {
+        addToHistory(a_sol, a_rhs);
+    }
+
     ++solve_called;
 
     return composite_norminf;
 }
 
+void
+MLMG::setInitialGuessHistory (int nvecs, HistoryGuess type)
+{
+    m_hist_max = std::max(nvecs,0);
+    m_hist_type = type;
+    clearInitialGuessHistory();
+}
+
+void
+MLMG::clearInitialGuessHistory ()
+{
+    m_hist_sol.clear();
+    m_hist_rhs.clear();
+}
+
+void
+MLMG::makeInitialGuessFromHistory (const Vector<MultiFab*>& a_sol,
+                                   const Vector<MultiFab const*>& a_rhs)
+{
+    BL_PROFILE("MLMG::makeInitialGuessFromHistory()");
+
+    if (m_hist_sol.empty()) return;
+
+    // The history is only usable on the grids it was built on.
+    for (int alev = 0; alev < namrlevs; ++alev) {
+        MultiFab const& h = m_hist_sol.back()[alev];
+        if (h.boxArray() != a_sol[alev]->boxArray() ||
+            h.DistributionMap() != a_sol[alev]->DistributionMap())
+        {
+            clearInitialGuessHistory();
+            return;
+        }
+    }
+
+    const int ncomp = linop.getNComp();
+    const int nhist = m_hist_sol.size();
+    Vector<Real> coef(nhist, 0.0);
+
+    if (m_hist_type == HistoryGuess::extrapolation)
+    {
+        // Extrapolation through the last nhist solutions, assumed to be
+        // equally spaced in time: 2x_n - x_{n-1}, 3x_n - 3x_{n-1} + x_{n-2}, ...
+        Real binom = 1.0;
+        for (int i = 0; i < nhist; ++i) {
+            binom = binom * Real(nhist-i) / Real(i+1);
+            coef[nhist-1-i] = (i%2 == 0) ? binom : -binom;
+        }
+    }
+    else
+    {
+        // Minimize |b - sum_i c_i b_i| over the stored rhs.  Then
+        // L(sum_i c_i x_i) is the best approximation of b in their span.
+        // G(i,j) = (b_i,b_j) and G(i,nhist) = (b_i,b).
+        const int ld = nhist+1;
+        Vector<Real> G(nhist*ld, 0.0);
+        for (int alev = 0; alev < namrlevs; ++alev) {
+            for (int i = 0; i < nhist; ++i) {
+                MultiFab const& bi = m_hist_rhs[i][alev];
+                for (int j = i; j < nhist; ++j) {
+                    G[i*ld+j] += MultiFab::Dot(bi, 0, m_hist_rhs[j][alev], 0, ncomp, 0, true);
+                }
+                G[i*ld+nhist] += MultiFab::Dot(bi, 0, *a_rhs[alev], 0, ncomp, 0, true);
+            }
+        }
+        ParallelAllReduce::Sum(G.data(), G.size(), ParallelContext::CommunicatorSub());
+        for (int i = 0; i < nhist; ++i) {
+            for (int j = 0; j < i; ++j) {
+                G[i*ld+j] = G[j*ld+i];
+            }
+        }
+
+        // Gaussian elimination.  Nearly linearly dependent rhs are dropped.
+        Vector<Real> diag0(nhist);
+        for (int i = 0; i < nhist; ++i) { diag0[i] = G[i*ld+i]; }
+        Vector<int> skip(nhist, 0);
+        for (int k = 0; k < nhist; ++k) {
+            const Real piv = G[k*ld+k];
+            if (piv <= Real(1.e-12)*diag0[k] || piv <= Real(0.0)) {
+                skip[k] = 1;
+                continue;
+            }
+            for (int i = k+1; i < nhist; ++i) {
+                const Real f = G[i*ld+k] / piv;
+                for (int j = k; j <= nhist; ++j) {
+                    G[i*ld+j] -= f * G[k*ld+j];
+                }
+            }
+        }
+        for (int k = nhist-1; k >= 0; --k) {
+            if (skip[k]) continue;
+            Real r = G[k*ld+nhist];
+            for (int j = k+1; j < nhist; ++j) {
+                r -= G[k*ld+j] * coef[j];
+            }
+            coef[k] = r / G[k*ld+k];
+        }
+    }
+
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        MultiFab& x = *a_sol[alev];
+
+        // For nodal solvers the Dirichlet data live on the domain boundary
+        // nodes of the solution itself, so they must be preserved.
+        MultiFab xbnd;
+        Box const nddomain = amrex::surroundingNodes(linop.Geom(alev).Domain());
+        Vector<Box> dirbnd;
+        if (!linop.isCellCentered()) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (linop.LoBC()[idim] == LinOpBCType::Dirichlet) {
+                    dirbnd.push_back(amrex::bdryLo(nddomain, idim));
+                }
+                if (linop.HiBC()[idim] == LinOpBCType::Dirichlet) {
+                    dirbnd.push_back(amrex::bdryHi(nddomain, idim));
+                }
+            }
+            if (!dirbnd.empty()) {
+                xbnd.define(x.boxArray(), x.DistributionMap(), ncomp, 0, MFInfo(), x.Factory());
+                MultiFab::Copy(xbnd, x, 0, 0, ncomp, 0);
+            }
+        }
+
+        x.setVal(0.0, 0, ncomp, 0);
+        for (int i = 0; i < nhist; ++i) {
+            if (coef[i] != Real(0.0)) {
+                MultiFab::Saxpy(x, coef[i], m_hist_sol[i][alev], 0, 0, ncomp, 0);
+            }
+        }
+
+        if (!dirbnd.empty()) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(x); mfi.isValid(); ++mfi)
+            {
+                auto const& xfab = x.array(mfi);
+                auto const& bfab = xbnd.const_array(mfi);
+                for (auto const& b : dirbnd) {
+                    const Box& bx = b & mfi.validbox();
+                    if (bx.ok()) {
+                        AMREX_HOST_DEVICE_PARALLEL_FOR_4D(bx, ncomp, i, j, k, n,
+                        {
+                            xfab(i,j,k,n) = bfab(i,j,k,n);
+                        });
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MLMG::addToHistory (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rhs)
+{
+    BL_PROFILE("MLMG::addToHistory()");
+
+    const int ncomp = linop.getNComp();
+
+    while (static_cast<int>(m_hist_sol.size()) >= m_hist_max) {
+        m_hist_sol.erase(m_hist_sol.begin());
+        if (!m_hist_rhs.empty()) m_hist_rhs.erase(m_hist_rhs.begin());
+    }
+
+    Vector<MultiFab> hsol(namrlevs);
+    for (int alev = 0; alev < namrlevs; ++alev) {
+        hsol[alev].define(a_sol[alev]->boxArray(), a_sol[alev]->DistributionMap(), ncomp, 0,
+                          MFInfo(), a_sol[alev]->Factory());
+        MultiFab::Copy(hsol[alev], *a_sol[alev], 0, 0, ncomp, 0);
+    }
+    m_hist_sol.push_back(std::move(hsol));
+
+    if (m_hist_type == HistoryGuess::projection) {
+        Vector<MultiFab> hrhs(namrlevs);
+        for (int alev = 0; alev < namrlevs; ++alev) {
+            hrhs[alev].define(a_rhs[alev]->boxArray(), a_rhs[alev]->DistributionMap(), ncomp, 0,
+                              MFInfo(), a_rhs[alev]->Factory());
+            MultiFab::Copy(hrhs[alev], *a_rhs[alev], 0, 0, ncomp, 0);
+        }
+        m_hist_rhs.push_back(std::move(hrhs));
+    }
+}
+
 // in  : Residual (res) on the finest AMR level
 // out : sol on all AMR levels
 void MLMG::oneIter (int iter)
@@ -434,24 +633,35 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
 
         cor[amrlev][mglev]->setVal(0.0);
         bool skip_fillboundary = true;
+        bool fused = false;
         for (int i = 0; i < nu1; ++i) {
+            // The last sweep, rescor and its restriction may be done in one go.
+            if (i == nu1-1 && fused_smoothing && verbose < 4) {
+                fused = linop.smoothResRestrict(amrlev, mglev, *cor[amrlev][mglev],
+                                                res[amrlev][mglev], res[amrlev][mglev+1],
+                                                skip_fillboundary);
+                if (fused) break;
+            }
             linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev],
                          skip_fillboundary);
             skip_fillboundary = false;
         }
 
-        // rescor = res - L(cor)
-        computeResOfCorrection(amrlev, mglev);
-
-        if (verbose >= 4)
+        if (!fused)
         {
-            Real norm = rescor[amrlev][mglev].norm0();
-            amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev
-                           << "   DN: Norm after  smooth " << norm << "\n";
-        }
+            // rescor = res - L(cor)
+            computeResOfCorrection(amrlev, mglev);
 
-        // res_crse = R(rescor_fine); this provides res/b to the level below
-        linop.restriction(amrlev, mglev+1, res[amrlev][mglev+1], rescor[amrlev][mglev]);
+            if (verbose >= 4)
+            {
+                Real norm = rescor[amrlev][mglev].norm0();
+                amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev
+                               << "   DN: Norm after  smooth " << norm << "\n";
+            }
+
+            // res_crse = R(rescor_fine); this provides res/b to the level below
+            linop.restriction(amrlev, mglev+1, res[amrlev][mglev+1], rescor[amrlev][mglev]);
+        }
 
     }
 
@@ -956,6 +1166,27 @@ MLMG::actualBottomSolve ()
         {
             bottomSolveWithPETSc(x, *bottom_b);
         }
+        else if (bottom_solver == BottomSolver::amg)
+        {
+            int ret = bottomSolveWithAMG(x, *bottom_b);
+            if (ret != 0) {
+                cor[amrlev][mglev]->setVal(0.0);
+            }
+            const int n = (ret==0) ? nub : nuf;
+            for (int i = 0; i < n; ++i) {
+                linop.smooth(amrlev, mglev, x, b);
+            }
+        }
+        else if (bottom_solver == BottomSolver::fft)
+        {
+            int ret = bottomSolveWithFFT(x, *bottom_b);
+            if (ret != 0) {
+                cor[amrlev][mglev]->setVal(0.0);
+                for (int i = 0; i < nuf; ++i) {
+                    linop.smooth(amrlev, mglev, x, b);
+                }
+            }
+        }
         else
         {
             MLCGSolver::Type cg_type;
@@ -1017,6 +1248,49 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
     return ret;
 }
 
+int
+MLMG::bottomSolveWithAMG (MultiFab& x, const MultiFab& b)
+{
+    BL_PROFILE("MLMG::bottomSolveWithAMG()");
+
+    if (amg_solver == nullptr)  // We should reuse the setup
+    {
+        amg_solver = std::make_unique<MLAMGSolver>(linop);
+        amg_solver->setStrongThreshold(amg_strong_threshold);
+        amg_solver->setMaxCoarseSize(amg_max_coarse_size);
+        amg_solver->setNumSweeps(amg_num_sweeps);
+    }
+    amg_solver->setVerbose(bottom_verbose);
+    amg_solver->setMaxIter(bottom_maxiter);
+
+    int ret = amg_solver->solve(x, b, bottom_reltol, bottom_abstol);
+    if (ret != 0 && verbose > 1) {
+        amrex::Print() << "MLMG: Bottom solve failed.\n";
+    }
+    m_niters_cg.push_back(amg_solver->getNumIters());
+    return ret;
+}
+
+int
+MLMG::bottomSolveWithFFT (MultiFab& x, const MultiFab& b)
+{
+    BL_PROFILE("MLMG::bottomSolveWithFFT()");
+
+    if (fft_solver == nullptr)  // We should reuse the setup
+    {
+        fft_solver = std::make_unique<MLFFTSolver>(linop);
+    }
+    fft_solver->setVerbose(bottom_verbose);
+    fft_solver->setMaxIter(bottom_maxiter);
+
+    int ret = fft_solver->solve(x, b, bottom_reltol, bottom_abstol);
+    if (ret != 0 && verbose > 1) {
+        amrex::Print() << "MLMG: Bottom solve failed.\n";
+    }
+    m_niters_cg.push_back(fft_solver->getNumIters());
+    return ret;
+}
+
 // Compute single-level masked inf-norm of Residual (res).
 Real
 MLMG::ResNormInf (int alev, bool local)
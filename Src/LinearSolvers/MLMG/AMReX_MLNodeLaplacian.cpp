@@ -997,14 +997,19 @@ void
 MLNodeLaplacian::buildStencil ()
 {
     m_stencil.resize(m_num_amr_levels);
+    m_stencil_sp.resize(m_num_amr_levels);
     m_s0_norm0.resize(m_num_amr_levels);
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
     {
         m_stencil[amrlev].resize(m_num_mg_levels[amrlev]);
+        m_stencil_sp[amrlev].resize(m_num_mg_levels[amrlev]);
         m_s0_norm0[amrlev].resize(m_num_mg_levels[amrlev],0.0);
     }
 
-    if (m_coarsening_strategy != CoarseningStrategy::RAP) return;
+    if (m_coarsening_strategy != CoarseningStrategy::RAP) {
+        buildStoredStencil();
+        return;
+    }
 
     const int ncomp_s = (AMREX_SPACEDIM == 2) ? 5 : 9;
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(AMREX_SPACEDIM != 1,
@@ -1211,6 +1216,150 @@ MLNodeLaplacian::buildStencil ()
     m_s0_norm0[0].back() = m_stencil[0].back()->norm0(0,0) * m_normalization_threshold;
 }
 
+void
+MLNodeLaplacian::buildStoredStencil ()
+{
+    BL_PROFILE("MLNodeLaplacian::buildStoredStencil()");
+
+    for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
+    {
+        for (auto& p : m_stencil[amrlev]) p.reset();
+        for (auto& p : m_stencil_sp[amrlev]) p.reset();
+    }
+
+#if (AMREX_SPACEDIM > 1)
+    if (m_stencil_memory_budget == 0 || m_sigma[0][0][0] == nullptr || m_is_rz) return;
+
+    const int ncomp_s = (AMREX_SPACEDIM == 2) ? 5 : 9;
+
+    // Candidate levels ordered by how much recomputation they save: the
+    // first MG level of every AMR level (finest first), then the coarser MG
+    // levels.  The inverse diagonal component is only needed by the RAP
+    // interpolation, so it is dropped from the single precision copies.
+    Vector<std::pair<int,int> > candidates;
+    Vector<Long> nbytes;
+    const int max_mg_levels = *std::max_element(m_num_mg_levels.begin(), m_num_mg_levels.end());
+    for (int mglev = 0; mglev < max_mg_levels; ++mglev) {
+        for (int amrlev = m_num_amr_levels-1; amrlev >= 0; --amrlev) {
+            if (mglev >= m_num_mg_levels[amrlev]) continue;
+            if (m_use_harmonic_average && mglev > 0) continue;
+            if (amrlev == 0 && mglev > 0 && mg_coarsen_ratio_vec[mglev-1] != mg_coarsen_ratio) continue;
+            const MultiFab& sigma = *m_sigma[amrlev][mglev][0];
+            Long npts = 0;
+            for (MFIter mfi(sigma); mfi.isValid(); ++mfi) {
+                npts += amrex::surroundingNodes(mfi.validbox()).grow(1).numPts();
+            }
+            candidates.push_back({amrlev,mglev});
+            nbytes.push_back((mglev == 0) ? npts*ncomp_s*sizeof(Real)
+                                          : npts*(ncomp_s-1)*sizeof(float));
+        }
+    }
+    ParallelAllReduce::Max(nbytes.data(), nbytes.size(), ParallelContext::CommunicatorSub());
+
+    Long bytes_used = 0;
+    for (int icand = 0; icand < candidates.size(); ++icand)
+    {
+        if (m_stencil_memory_budget > 0 && bytes_used + nbytes[icand] > m_stencil_memory_budget) {
+            continue;
+        }
+        bytes_used += nbytes[icand];
+
+        const int amrlev = candidates[icand].first;
+        const int mglev = candidates[icand].second;
+        const Geometry& geom = m_geom[amrlev][mglev];
+        const auto dxinvarr = geom.InvCellSizeArray();
+        const MultiFab& sigma = *m_sigma[amrlev][mglev][0];
+
+        auto stencil = std::make_unique<MultiFab>(amrex::convert(m_grids[amrlev][mglev],
+                                                                 IntVect::TheNodeVector()),
+                                                  m_dmap[amrlev][mglev], ncomp_s, 1);
+        stencil->setVal(0.0);
+
+        MFItInfo mfi_info;
+        if (Gpu::notInLaunchRegion()) mfi_info.EnableTiling().SetDynamic(true);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        {
+            FArrayBox sgfab;
+            for (MFIter mfi(*stencil,mfi_info); mfi.isValid(); ++mfi)
+            {
+                Box vbx = mfi.validbox();
+                AMREX_D_TERM(vbx.growLo(0,1);, vbx.growLo(1,1);, vbx.growLo(2,1));
+                Box bx = mfi.growntilebox(1);
+                bx &= vbx;
+                const Box& ccbxg1 = amrex::grow(amrex::enclosedCells(bx),1);
+                const Box& btmp = ccbxg1 & sigma[mfi].box();
+                Array4<Real const> const& sgarr_orig = sigma.const_array(mfi);
+
+                sgfab.resize(ccbxg1);
+                Elixir sgeli = sgfab.elixir();
+                Array4<Real> const& sgarr = sgfab.array();
+                AMREX_HOST_DEVICE_FOR_3D(ccbxg1, i, j, k,
+                {
+                    if (btmp.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                        sgarr(i,j,k) = sgarr_orig(i,j,k);
+                    } else {
+                        sgarr(i,j,k) = 0.0;
+                    }
+                });
+
+                Array4<Real> const& starr = stencil->array(mfi);
+                AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( bx, tbx,
+                {
+                    mlndlap_set_stencil(tbx,starr,sgarr,dxinvarr);
+                });
+            }
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(*stencil,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& starr = stencil->array(mfi);
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+            {
+                mlndlap_set_stencil_s0(i,j,k,starr);
+            });
+        }
+
+        stencil->FillBoundary(geom.periodicity());
+
+        if (mglev == 0)
+        {
+            m_stencil[amrlev][mglev] = std::move(stencil);
+        }
+        else
+        {
+            auto& stencil_sp = m_stencil_sp[amrlev][mglev];
+            stencil_sp.reset(new FabArray<BaseFab<float> >(stencil->boxArray(),
+                                                           stencil->DistributionMap(),
+                                                           ncomp_s-1, 1));
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(*stencil_sp,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.growntilebox();
+                Array4<float> const& dst = stencil_sp->array(mfi);
+                Array4<Real const> const& src = stencil->const_array(mfi);
+                AMREX_HOST_DEVICE_PARALLEL_FOR_4D(bx, ncomp_s-1, i, j, k, n,
+                {
+                    dst(i,j,k,n) = static_cast<float>(src(i,j,k,n));
+                });
+            }
+        }
+    }
+
+    if (verbose > 1) {
+        amrex::Print() << "MLNodeLaplacian: stored stencil uses " << bytes_used
+                       << " bytes per rank\n";
+    }
+#endif
+}
+
 void
 MLNodeLaplacian::fixUpResidualMask (int amrlev, iMultiFab& resmsk)
 {
@@ -1527,6 +1676,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
 
     const auto& sigma = m_sigma[amrlev][mglev];
     const auto& stencil = m_stencil[amrlev][mglev];
+    const auto& stencil_sp = m_stencil_sp[amrlev][mglev];
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -1544,7 +1694,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
         Array4<Real> const& yarr = out.array(mfi);
         Array4<int const> const& dmskarr = dmsk.const_array(mfi);
 
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
+        if (stencil)
         {
             Array4<Real const> const& stenarr = stencil->const_array(mfi);
             AMREX_HOST_DEVICE_PARALLEL_FOR_3D ( bx, i, j, k,
@@ -1552,6 +1702,14 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
                 yarr(i,j,k) = mlndlap_adotx_sten(i,j,k,xarr,stenarr,dmskarr);
             });
         }
+        else if (stencil_sp)
+        {
+            Array4<float const> const& stenarr = stencil_sp->const_array(mfi);
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D ( bx, i, j, k,
+            {
+                yarr(i,j,k) = mlndlap_adotx_sten(i,j,k,xarr,stenarr,dmskarr);
+            });
+        }
         else if (sigma[0] == nullptr)
         {
             Real const_sigma = m_const_sigma;
@@ -1611,6 +1769,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 
     const auto& sigma = m_sigma[amrlev][mglev];
     const auto& stencil = m_stencil[amrlev][mglev];
+    const auto& stencil_sp = m_stencil_sp[amrlev][mglev];
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -1631,7 +1790,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                 Array4<Real const> const& rhsarr = rhs.const_array(mfi);
                 Array4<int const> const& dmskarr = dmsk.const_array(mfi);
 
-                if (m_coarsening_strategy == CoarseningStrategy::RAP)
+                if (stencil)
                 {
                     Array4<Real const> const& starr = stencil->const_array(mfi);
                     amrex::ParallelFor(Gpu::KernelInfo().setFusible(true), bx,
@@ -1641,6 +1800,16 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                         mlndlap_jacobi_sten(i,j,k,solarr,Ax,rhsarr,starr,dmskarr);
                     });
                 }
+                else if (stencil_sp)
+                {
+                    Array4<float const> const& starr = stencil_sp->const_array(mfi);
+                    amrex::ParallelFor(Gpu::KernelInfo().setFusible(true), bx,
+                                       [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        Real Ax = mlndlap_adotx_sten(i,j,k,solarr,starr,dmskarr);
+                        mlndlap_jacobi_sten(i,j,k,solarr,Ax,rhsarr,starr,dmskarr);
+                    });
+                }
                 else if (sigma[0] == nullptr)
                 {
                     Real const_sigma = m_const_sigma;
@@ -1709,7 +1878,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
         constexpr int nsweeps = 2;
         if (m_use_gauss_seidel)
         {
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
+            if (stencil)
             {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
@@ -1727,6 +1896,24 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                     }
                 }
             }
+            else if (stencil_sp)
+            {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(sol); mfi.isValid(); ++mfi)
+                {
+                    const Box& bx = mfi.validbox();
+                    Array4<Real> const& solarr = sol.array(mfi);
+                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                    Array4<float const> const& starr = stencil_sp->const_array(mfi);
+                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+                    for (int ns = 0; ns < nsweeps; ++ns) {
+                        mlndlap_gauss_seidel_sten(bx,solarr,rhsarr,starr,dmskarr);
+                    }
+                }
+            }
             else if (sigma[0] == nullptr)
             {
                 Real const_sigma = m_const_sigma;
@@ -1820,7 +2007,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
             MultiFab Ax(sol.boxArray(), sol.DistributionMap(), 1, 0);
             Fapply(amrlev, mglev, Ax, sol);
 
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
+            if (stencil)
             {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
@@ -1837,6 +2024,23 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                     mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
                 }
             }
+            else if (stencil_sp)
+            {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(sol,true); mfi.isValid(); ++mfi)
+                {
+                    const Box& bx = mfi.tilebox();
+                    Array4<Real> const& solarr = sol.array(mfi);
+                    Array4<Real const> const& Axarr = Ax.const_array(mfi);
+                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                    Array4<float const> const& stenarr = stencil_sp->const_array(mfi);
+                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+                    mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
+                }
+            }
             else if (sigma[0] == nullptr)
             {
                 Real const_sigma = m_const_sigma;
@@ -1949,6 +2153,17 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
     }
 }
 
+bool
+MLNodeLaplacian::isBottomConstantLaplacian (Real& a_scale) const
+{
+    a_scale = m_const_sigma;
+    if (m_sigma[0][0][0] != nullptr || m_is_rz || m_overset_dirichlet_mask) return false;
+#ifdef AMREX_USE_EB
+    if (dynamic_cast<EBFArrayBoxFactory const*>(m_factory[0][0].get())) return false;
+#endif
+    return true;
+}
+
 void
 MLNodeLaplacian::compSyncResidualCoarse (MultiFab& sync_resid, const MultiFab& a_phi,
                                          const MultiFab& vold, const MultiFab* rhcc,
@@ -359,6 +359,115 @@ MLPoisson::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs, i
     }
 }
 
+void
+MLPoisson::FsmoothResRestrict (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
+                               MultiFab& crse_res) const
+{
+    BL_PROFILE("MLPoisson::FsmoothResRestrict()");
+
+#if (AMREX_SPACEDIM == 1)
+    amrex::ignore_unused(amrlev,mglev,sol,rhs,crse_res);
+#else
+    const auto& undrrelxr = m_undrrelxr[amrlev][mglev];
+    const auto& maskvals  = m_maskvals [amrlev][mglev];
+
+    OrientationIter oitr;
+
+    const FabSet& f0 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f1 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f2 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f3 = undrrelxr[oitr()]; ++oitr;
+#if (AMREX_SPACEDIM > 2)
+    const FabSet& f4 = undrrelxr[oitr()]; ++oitr;
+    const FabSet& f5 = undrrelxr[oitr()]; ++oitr;
+#endif
+
+    const MultiMask& mm0 = maskvals[0];
+    const MultiMask& mm1 = maskvals[1];
+    const MultiMask& mm2 = maskvals[2];
+    const MultiMask& mm3 = maskvals[3];
+#if (AMREX_SPACEDIM > 2)
+    const MultiMask& mm4 = maskvals[4];
+    const MultiMask& mm5 = maskvals[5];
+#endif
+
+    const Real* dxinv = m_geom[amrlev][mglev].InvCellSize();
+    AMREX_D_TERM(const Real dhx = dxinv[0]*dxinv[0];,
+                 const Real dhy = dxinv[1]*dxinv[1];,
+                 const Real dhz = dxinv[2]*dxinv[2];);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(sol,fusedTileInfo()); mfi.isValid(); ++mfi)
+    {
+        const Box& tbx = mfi.tilebox();
+        const Box& vbx = mfi.validbox();
+        const auto& solnfab = sol.array(mfi);
+        const auto& rhsfab  = rhs.const_array(mfi);
+        const auto& crsefab = crse_res.array(mfi);
+
+        const auto& m0 = mm0.array(mfi);
+        const auto& m1 = mm1.array(mfi);
+        const auto& m2 = mm2.array(mfi);
+        const auto& m3 = mm3.array(mfi);
+        const auto& f0fab = f0.array(mfi);
+        const auto& f1fab = f1.array(mfi);
+        const auto& f2fab = f2.array(mfi);
+        const auto& f3fab = f3.array(mfi);
+#if (AMREX_SPACEDIM == 2)
+        mlpoisson_gsrb_res_restrict(tbx, crsefab, solnfab, rhsfab, dhx, dhy,
+                                    f0fab, m0,
+                                    f1fab, m1,
+                                    f2fab, m2,
+                                    f3fab, m3,
+                                    vbx);
+#else
+        const auto& m4 = mm4.array(mfi);
+        const auto& m5 = mm5.array(mfi);
+        const auto& f4fab = f4.array(mfi);
+        const auto& f5fab = f5.array(mfi);
+        mlpoisson_gsrb_res_restrict(tbx, crsefab, solnfab, rhsfab, dhx, dhy, dhz,
+                                    f0fab, m0,
+                                    f1fab, m1,
+                                    f2fab, m2,
+                                    f3fab, m3,
+                                    f4fab, m4,
+                                    f5fab, m5,
+                                    vbx);
+#endif
+    }
+#endif
+}
+
+void
+MLPoisson::FresRestrictTileBndry (int amrlev, int mglev, const MultiFab& sol,
+                                  const MultiFab& rhs, MultiFab& crse_res) const
+{
+    BL_PROFILE("MLPoisson::FresRestrictTileBndry()");
+
+    const Real* dxinv = m_geom[amrlev][mglev].InvCellSize();
+    AMREX_D_TERM(const Real dhx = dxinv[0]*dxinv[0];,
+                 const Real dhy = dxinv[1]*dxinv[1];,
+                 const Real dhz = dxinv[2]*dxinv[2];);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(sol,fusedTileInfo()); mfi.isValid(); ++mfi)
+    {
+        const Box& cbx = amrex::coarsen(mfi.tilebox(),2);
+        const auto& solnfab = sol.const_array(mfi);
+        const auto& rhsfab  = rhs.const_array(mfi);
+        const auto& crsefab = crse_res.array(mfi);
+#if (AMREX_SPACEDIM == 1)
+        amrex::ignore_unused(cbx,solnfab,rhsfab,crsefab,dhx);
+#else
+        mlpoisson_res_restrict_shell(cbx, crsefab, solnfab, rhsfab, AMREX_D_DECL(dhx,dhy,dhz));
+#endif
+    }
+}
+
 void
 MLPoisson::FFlux (int amrlev, const MFIter& mfi,
                   const Array<FArrayBox*,AMREX_SPACEDIM>& flux,
@@ -331,6 +331,8 @@ MacProjector::setOptions ()
     Real         bottom_rtol(1.0e-4_rt);
     Real         bottom_atol(-1.0_rt);
     std::string  bottom_solver("bicg");
+    int          init_guess_history(0);
+    std::string  init_guess_type("projection");
 
     int num_pre_smooth(2);
     int num_post_smooth(2);
@@ -349,6 +351,9 @@ MacProjector::setOptions ()
     pp.query( "num_pre_smooth"  , num_pre_smooth );
     pp.query( "num_post_smooth" , num_post_smooth );
 
+    pp.query( "init_guess_history", init_guess_history );
+    pp.query( "init_guess_type"   , init_guess_type );
+
     // Set default/input values
     m_linop->setMaxOrder(maxorder);
     m_mlmg->setVerbose(m_verbose);
@@ -361,6 +366,17 @@ MacProjector::setOptions ()
     m_mlmg->setPreSmooth(num_pre_smooth);
     m_mlmg->setPostSmooth(num_post_smooth);
 
+    if (init_guess_history > 0)
+    {
+        if (init_guess_type == "projection") {
+            m_mlmg->setInitialGuessHistory(init_guess_history, MLMG::HistoryGuess::projection);
+        } else if (init_guess_type == "extrapolation") {
+            m_mlmg->setInitialGuessHistory(init_guess_history, MLMG::HistoryGuess::extrapolation);
+        } else {
+            amrex::Abort("Unknown init_guess_type " + init_guess_type);
+        }
+    }
+
     if (bottom_solver == "smoother")
     {
         m_mlmg->setBottomSolver(MLMG::BottomSolver::smoother);
@@ -381,6 +397,10 @@ MacProjector::setOptions ()
     {
         m_mlmg->setBottomSolver(MLMG::BottomSolver::cgbicg);
     }
+    else if (bottom_solver == "amg")
+    {
+        m_mlmg->setBottomSolver(MLMG::BottomSolver::amg);
+    }
     else if (bottom_solver == "hypre")
     {
 #ifdef AMREX_USE_HYPRE
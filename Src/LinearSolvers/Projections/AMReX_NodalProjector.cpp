@@ -146,6 +146,9 @@ NodalProjector::setOptions ()
     Real         bottom_rtol(1.0e-4_rt);
     Real         bottom_atol(-1.0_rt);
     std::string  bottom_solver("bicgcg");
+    int          init_guess_history(0);
+    std::string  init_guess_type("projection");
+    Long         stencil_memory_budget(0);
 
     int          num_pre_smooth (2);
     int          num_post_smooth(2);
@@ -163,6 +166,11 @@ NodalProjector::setOptions ()
     pp.query( "num_pre_smooth"  , num_pre_smooth );
     pp.query( "num_post_smooth" , num_post_smooth );
 
+    pp.query( "init_guess_history", init_guess_history );
+    pp.query( "init_guess_type"   , init_guess_type );
+
+    pp.query( "stencil_memory_budget", stencil_memory_budget );
+
     // Set default/input values
     m_mlmg->setVerbose(m_verbose);
     m_mlmg->setBottomVerbose(bottom_verbose);
@@ -174,6 +182,19 @@ NodalProjector::setOptions ()
     m_mlmg->setPreSmooth(num_pre_smooth);
     m_mlmg->setPostSmooth(num_post_smooth);
 
+    m_linop->setStencilStorage(stencil_memory_budget);
+
+    if (init_guess_history > 0)
+    {
+        if (init_guess_type == "projection") {
+            m_mlmg->setInitialGuessHistory(init_guess_history, MLMG::HistoryGuess::projection);
+        } else if (init_guess_type == "extrapolation") {
+            m_mlmg->setInitialGuessHistory(init_guess_history, MLMG::HistoryGuess::extrapolation);
+        } else {
+            amrex::Abort("Unknown init_guess_type " + init_guess_type);
+        }
+    }
+
     if (bottom_solver == "smoother")
     {
         m_mlmg->setBottomSolver(MLMG::BottomSolver::smoother);
@@ -194,6 +215,10 @@ NodalProjector::setOptions ()
     {
         m_mlmg->setBottomSolver(MLMG::BottomSolver::cgbicg);
     }
+    else if (bottom_solver == "fft")
+    {
+        m_mlmg->setBottomSolver(MLMG::BottomSolver::fft);
+    }
 #ifdef AMREX_USE_HYPRE
     else if (bottom_solver == "hypre")
     {
@@ -0,0 +1,321 @@
+//
+// Advects a Gaussian on three levels with reflux, once with the usual
+// recursive advance and once with amr.task_graph = 1, where each level is
+// advanced together with the first substep of the next finer level, and
+// checks that the results are identical.  Then both are run again with a
+// post-step regrid of level 0 after every step, which with amr.task_graph = 1
+// is done after the first substep of level 1, and checks that the two runs
+// stay close.
+//
+
+#include <AMReX.H>
+#include <AMReX_Amr.H>
+#include <AMReX_AmrLevel.H>
+#include <AMReX_FluxRegister.H>
+#include <AMReX_LevelBld.H>
+#include <AMReX_MultiFabUtil.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <cmath>
+
+using namespace amrex;
+
+namespace {
+
+void nullfill (Box const&, FArrayBox&, const int, const int, Geometry const&, const Real,
+               const Vector<BCRec>&, const int, const int)
+{}
+
+Real dt_coarse = 0.0125;
+
+bool post_step_regrid = false;
+
+}
+
+class AdvLevel
+    : public AmrLevel
+{
+public:
+
+    AdvLevel () {}
+
+    AdvLevel (Amr& papa, int lev, const Geometry& level_geom, const BoxArray& ba,
+              const DistributionMapping& dm, Real time)
+        : AmrLevel(papa, lev, level_geom, ba, dm, time)
+    {
+        if (level > 0) {
+            flux_reg.reset(new FluxRegister(grids, dmap, crse_ratio, level, 1));
+        }
+    }
+
+    static void variableSetUp ()
+    {
+        desc_lst.addDescriptor(0, IndexType::TheCellType(), StateDescriptor::Point, 0, 1,
+                               &cell_cons_interp);
+        BCRec bc;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bc.setLo(idim, BCType::int_dir);
+            bc.setHi(idim, BCType::int_dir);
+        }
+        desc_lst.setComponent(0, 0, "phi", bc, StateDescriptor::BndryFunc(nullfill));
+    }
+
+    static void variableCleanUp () { desc_lst.clear(); }
+
+    virtual void computeInitialDt (int, int, Vector<int>& n_cycle, const Vector<IntVect>&,
+                                   Vector<Real>& dt_level, Real) override
+    {
+        setDt(n_cycle, dt_level);
+    }
+
+    virtual void computeNewDt (int, int, Vector<int>& n_cycle, const Vector<IntVect>&,
+                               Vector<Real>&, Vector<Real>& dt_level, Real, int) override
+    {
+        setDt(n_cycle, dt_level);
+    }
+
+    virtual bool supportsBoxAdvance () const override { return true; }
+
+    virtual int boxAdvanceNGrow () const override { return 1; }
+
+    virtual void advanceBegin (Real, Real dt, int, int) override
+    {
+        for (int k = 0; k < desc_lst.size(); ++k) {
+            state[k].allocOldData();
+            state[k].swapTimeLevels(dt);
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            fluxes[idim].define(amrex::convert(grids, IntVect::TheDimensionVector(idim)),
+                                dmap, 1, 0);
+        }
+        if (level < parent->finestLevel()) {
+            getLevel(level+1).flux_reg->setVal(0.0);
+        }
+    }
+
+    // First order upwind with a constant positive velocity
+    virtual void advanceBox (const MultiFab& S, int gridno, Real, Real dt, int, int) override
+    {
+        const Box& bx = grids[gridno];
+        const auto dx = geom.CellSizeArray();
+        const auto s = S.const_array(gridno);
+        const auto snew = get_new_data(0).array(gridno);
+        const Real vol = AMREX_D_TERM(dx[0],*dx[1],*dx[2]);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            const auto f = fluxes[idim].array(gridno);
+            const Real vel_dt_area = Real(1.0)/(idim+1) * dt * vol / dx[idim];
+            const Dim3 sh = IntVect::TheDimensionVector(idim).dim3();
+            amrex::LoopOnCpu(amrex::surroundingNodes(bx,idim), [&] (int i, int j, int k)
+            {
+                f(i,j,k) = vel_dt_area * s(i-sh.x,j-sh.y,k-sh.z);
+            });
+        }
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+        {
+            Real div = 0.0;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const auto f = fluxes[idim].const_array(gridno);
+                const Dim3 sh = IntVect::TheDimensionVector(idim).dim3();
+                div += f(i+sh.x,j+sh.y,k+sh.z) - f(i,j,k);
+            }
+            snew(i,j,k) = s(i,j,k) - div/vol;
+        });
+    }
+
+    virtual Real advanceEnd (Real, Real dt, int, int) override
+    {
+        if (level == 0 && post_step_regrid) {
+            setPostStepRegrid(1);
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (level < parent->finestLevel()) {
+                getLevel(level+1).flux_reg->CrseInit(fluxes[idim], idim, 0, 0, 1, -1.0);
+            }
+            if (level > 0) {
+                flux_reg->FineAdd(fluxes[idim], idim, 0, 0, 1, 1.0);
+            }
+        }
+        return dt;
+    }
+
+    virtual Real advance (Real time, Real dt, int iteration, int ncycle) override
+    {
+        return advanceByBoxes(time, dt, iteration, ncycle);
+    }
+
+    virtual void post_timestep (int) override
+    {
+        if (level < parent->finestLevel()) {
+            AdvLevel& fine = getLevel(level+1);
+            fine.flux_reg->Reflux(get_new_data(0), 1.0, 0, 0, 1, geom);
+            amrex::average_down(fine.get_new_data(0), get_new_data(0), 0, 1,
+                                parent->refRatio(level));
+        }
+    }
+
+    virtual void post_regrid (int, int) override {}
+
+    virtual void post_init (Real) override {}
+
+    virtual void initData () override
+    {
+        MultiFab& S = get_new_data(0);
+        const auto dx = geom.CellSizeArray();
+        for (MFIter mfi(S); mfi.isValid(); ++mfi) {
+            const auto a = S.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k)
+            {
+                const Real x = (i+0.5)*dx[0]-0.5;
+                const Real y = (AMREX_SPACEDIM > 1) ? (j+0.5)*dx[1]-0.5 : 0.0;
+                const Real z = (AMREX_SPACEDIM > 2) ? (k+0.5)*dx[2]-0.5 : 0.0;
+                a(i,j,k) = 1.0 + std::exp(-(x*x+y*y+z*z)*40.);
+            });
+        }
+    }
+
+    virtual void init (AmrLevel& old) override
+    {
+        const Real cur  = old.get_state_data(0).curTime();
+        const Real prev = old.get_state_data(0).prevTime();
+        setTimeLevel(cur, cur-prev, parent->dtLevel(level));
+        FillPatch(old, get_new_data(0), 0, cur, 0, 0, 1);
+    }
+
+    virtual void init () override
+    {
+        const StateData& crse_state = parent->getLevel(level-1).get_state_data(0);
+        const Real cur  = crse_state.curTime();
+        const Real prev = crse_state.prevTime();
+        setTimeLevel(cur, (cur-prev)/parent->nCycle(level), parent->dtLevel(level));
+        FillCoarsePatch(get_new_data(0), 0, cur, 0, 0, 1);
+    }
+
+    virtual void errorEst (TagBoxArray& tags, int, int, Real, int, int) override
+    {
+        const MultiFab& S = get_new_data(0);
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi) {
+            const auto t = tags.array(mfi);
+            const auto s = S.const_array(mfi);
+            const Real threshold = 1.1 + 0.3*level;
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k)
+            {
+                if (s(i,j,k) > threshold) { t(i,j,k) = TagBox::SET; }
+            });
+        }
+    }
+
+private:
+
+    AdvLevel& getLevel (int lev) { return dynamic_cast<AdvLevel&>(parent->getLevel(lev)); }
+
+    void setDt (Vector<int>& n_cycle, Vector<Real>& dt_level)
+    {
+        Real dt = dt_coarse;
+        for (int lev = 0; lev < dt_level.size(); ++lev) {
+            dt_level[lev] = dt;
+            if (lev+1 < dt_level.size()) { dt /= n_cycle[lev+1]; }
+        }
+    }
+
+    std::unique_ptr<FluxRegister> flux_reg;
+    Array<MultiFab,AMREX_SPACEDIM> fluxes;
+};
+
+class AdvLevelBld
+    : public LevelBld
+{
+    virtual void variableSetUp () override { AdvLevel::variableSetUp(); }
+    virtual void variableCleanUp () override { AdvLevel::variableCleanUp(); }
+    virtual AmrLevel* operator() () override { return new AdvLevel; }
+    virtual AmrLevel* operator() (Amr& papa, int lev, const Geometry& level_geom,
+                                  const BoxArray& ba, const DistributionMapping& dm,
+                                  Real time) override
+    {
+        return new AdvLevel(papa, lev, level_geom, ba, dm, time);
+    }
+};
+
+AdvLevelBld adv_bld;
+
+LevelBld* getLevelBld () { return &adv_bld; }
+
+// Runs nsteps coarse steps and returns the data of all levels.
+Vector<std::unique_ptr<MultiFab> > run (int task_graph, int nsteps, bool a_post_step_regrid)
+{
+    post_step_regrid = a_post_step_regrid;
+    {
+        ParmParse pp("amr");
+        pp.add("task_graph", task_graph);
+    }
+
+    Amr amr;
+    amr.init(0.0, 1.e10);
+    for (int step = 0; step < nsteps; ++step) {
+        amr.coarseTimeStep(1.e10);
+    }
+
+    Vector<std::unique_ptr<MultiFab> > r;
+    for (int lev = 0; lev <= amr.finestLevel(); ++lev) {
+        const MultiFab& S = amr.getLevel(lev).get_new_data(0);
+        r.emplace_back(new MultiFab(S.boxArray(), S.DistributionMap(), 1, 0));
+        MultiFab::Copy(*r.back(), S, 0, 0, 1, 0);
+    }
+    return r;
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nsteps = 8;
+        {
+            ParmParse pp;
+            pp.query("nsteps", nsteps);
+            pp.query("dt", dt_coarse);
+        }
+
+        const auto recursive = run(0, nsteps, false);
+        const auto together  = run(1, nsteps, false);
+
+        AMREX_ALWAYS_ASSERT(recursive.size() == together.size());
+        for (int lev = 0; lev < recursive.size(); ++lev)
+        {
+            const MultiFab& a = *recursive[lev];
+            const MultiFab& b = *together[lev];
+            AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray());
+            // The DistributionMappings may differ.
+            MultiFab d(a.boxArray(), a.DistributionMap(), 1, 0);
+            d.ParallelCopy(b);
+            MultiFab::Subtract(d, a, 0, 0, 1, 0);
+            const Real diff = d.norm0();
+            amrex::Print() << "Level " << lev << ": " << a.boxArray().size()
+                           << " boxes, sum " << a.sum() << ", max difference " << diff << "\n";
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(diff == 0.0,
+                "amr.task_graph = 1 does not reproduce the recursive advance");
+        }
+
+        // The regrids happen at different fine times, so only the coarse
+        // data are compared, with a tolerance.
+        const auto recursive_psr = run(0, nsteps, true);
+        const auto together_psr  = run(1, nsteps, true);
+        {
+            const MultiFab& a = *recursive_psr[0];
+            const MultiFab& b = *together_psr[0];
+            MultiFab d(a.boxArray(), a.DistributionMap(), 1, 0);
+            d.ParallelCopy(b);
+            MultiFab::Subtract(d, a, 0, 0, 1, 0);
+            const Real diff = d.norm0();
+            amrex::Print() << "With post-step regrid: level 0 max difference " << diff << "\n";
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(diff <= 1.e-3*a.norm0(),
+                "amr.task_graph = 1 with post-step regrid differs from the recursive advance");
+        }
+    }
+    amrex::Finalize();
+}
+
+#ifndef AMREX_NO_PROBINIT
+extern "C" void amrex_probinit (const int*, const int*, const int*,
+                                const amrex_real*, const amrex_real*)
+{}
+#endif
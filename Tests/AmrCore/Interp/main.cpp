@@ -0,0 +1,241 @@
+//
+// Regression test of the CPU kernels of the cell-centered interpolaters.
+//
+// CellConservativeLinear, with either limiter, is compared with the
+// separate slope and interpolation kernels that are still used on GPUs.
+// CellConservativeQuartic and, in 2D, CellQuadratic are compared with the
+// values that the Fortran kernels they replaced computed for the same
+// coarse data (reference.H).
+//
+
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_Interpolater.H>
+#include <AMReX_Interp_C.H>
+#include <AMReX_Print.H>
+
+#include "reference.H"
+
+using namespace amrex;
+
+namespace {
+
+#ifdef AMREX_USE_FLOAT
+constexpr Real tol = 1.e-5;
+#else
+constexpr Real tol = 1.e-12;
+#endif
+
+// Smooth except for a jump between coarse cells 5 and 6 in x.
+Real coarse_value (int i, int j, int k, int n)
+{
+    return std::sin(Real(0.9)*i + Real(0.3) + n) * std::cos(Real(0.6)*j) * (Real(1.) + Real(0.2)*k)
+        + ((i >= 6) ? Real(0.5) : Real(0.));
+}
+
+void fill_coarse (FArrayBox& crse)
+{
+    auto const& a = crse.array();
+    amrex::LoopOnCpu(crse.box(), crse.nComp(), [&] (int i, int j, int k, int n)
+    {
+        a(i,j,k,n) = coarse_value(i,j,k,n);
+    });
+}
+
+// Number of values of fine over region that differ from those of ref.
+Long count_diff (const FArrayBox& fine, const Box& region, Array4<Real const> const& ref)
+{
+    Long r = 0;
+    auto const& a = fine.const_array();
+    amrex::LoopOnCpu(region, fine.nComp(), [&] (int i, int j, int k, int n)
+    {
+        if (std::abs(a(i,j,k,n) - ref(i,j,k,n)) > tol*(Real(1.) + std::abs(ref(i,j,k,n)))) {
+            ++r;
+        }
+    });
+    return r;
+}
+
+Vector<BCRec> make_bcr (int ncomp)
+{
+    Vector<BCRec> bcr(ncomp);
+    for (auto& bc : bcr) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bc.setLo(idim, BCType::int_dir);
+            bc.setHi(idim, BCType::int_dir);
+        }
+    }
+    return bcr;
+}
+
+Geometry make_geom (const Box& domain)
+{
+    const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    return Geometry(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+}
+
+// CellConservativeLinear::interp on the GPU, run on the CPU.
+void cellconslin_per_cell (const FArrayBox& crse, FArrayBox& fine, int ncomp,
+                           const Box& fine_region, const IntVect& ratio,
+                           const Geometry& cgeom, const Geometry& fgeom,
+                           Vector<BCRec> const& bcr, bool linear_limiting)
+{
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
+    const Box& cslope_bx = amrex::coarsen(fine_region, ratio);
+    const int ntmp = linear_limiting ? (ncomp+1)*AMREX_SPACEDIM : ncomp*(AMREX_SPACEDIM+2);
+    FArrayBox ccfab(cslope_bx, ntmp);
+    Array4<Real> const& ccarr = ccfab.array();
+    const Vector<Real>& voff = amrex::ccinterp_compute_voff(cslope_bx, ratio, cgeom, fgeom);
+    if (linear_limiting) {
+        amrex::cellconslin_slopes_linlim(cslope_bx, ccarr, crsearr, 0, ncomp, bcr.data());
+    } else {
+        const Box& fslope_bx = amrex::refine(cslope_bx, ratio);
+        FArrayBox fafab(fslope_bx, ncomp);
+        Array4<Real> const& faarr = fafab.array();
+        amrex::cellconslin_slopes_mclim(cslope_bx, ccarr, crsearr, 0, ncomp, bcr.data());
+        amrex::cellconslin_fine_alpha(fslope_bx, faarr, ccarr, ncomp, voff.data(), ratio);
+        amrex::cellconslin_slopes_mmlim(cslope_bx, ccarr, faarr, ncomp, ratio);
+    }
+    amrex::cellconslin_interp(fine_region, finearr, 0, ncomp, ccarr, crsearr, 0,
+                              voff.data(), ratio);
+}
+
+int test_cellconslin ()
+{
+    const Box cdomain(IntVect(0), IntVect(15));
+    const Geometry cgeom = make_geom(cdomain);
+
+    // Component 0 is interior, the others have physical boundaries.
+    const int ncomp = 3;
+    Vector<BCRec> bcr = make_bcr(ncomp);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        bcr[1].setLo(idim, BCType::ext_dir);
+        bcr[1].setHi(idim, BCType::hoextrap);
+        bcr[2].setLo(idim, BCType::foextrap);
+        bcr[2].setHi(idim, BCType::reflect_even);
+    }
+
+    int nerrors = 0;
+    for (const IntVect& ratio : {IntVect(2), IntVect(4), IntVect(AMREX_D_DECL(2,4,2))})
+    {
+        const Geometry fgeom = make_geom(amrex::refine(cdomain, ratio));
+        const Box& fdomain = fgeom.Domain();
+        for (const Box& fine_region : {Box(fdomain.smallEnd(), fdomain.smallEnd()+IntVect(13)),
+                                       Box(IntVect(9), fdomain.bigEnd()-IntVect(5))})
+        {
+            CellConservativeLinear interp_lin(true);
+            CellConservativeLinear interp_mc(false);
+            for (auto* interp : {&interp_lin, &interp_mc})
+            {
+                const bool linear_limiting = (interp == &interp_lin);
+                FArrayBox crse(interp->CoarseBox(fine_region, ratio), ncomp);
+                fill_coarse(crse);
+
+                FArrayBox fine(fine_region, ncomp);
+                interp->interp(crse, 0, fine, 0, ncomp, fine_region, ratio, cgeom, fgeom,
+                               bcr, 0, 0, RunOn::Cpu);
+
+                FArrayBox fine_ref(fine_region, ncomp);
+                cellconslin_per_cell(crse, fine_ref, ncomp, fine_region, ratio, cgeom, fgeom,
+                                     bcr, linear_limiting);
+
+                const Long n = count_diff(fine, fine_region, fine_ref.const_array());
+                amrex::Print() << "CellConservativeLinear, "
+                               << (linear_limiting ? "linear" : "mc") << " limiter, ratio "
+                               << ratio << ", fine region " << fine_region << ": "
+                               << n << " wrong values\n";
+                if (n != 0) { ++nerrors; }
+            }
+        }
+    }
+    return nerrors;
+}
+
+int test_quartic ()
+{
+    const Box cdomain(IntVect(0), IntVect(15));
+    const IntVect ratio(2);
+    const Geometry cgeom = make_geom(cdomain);
+    const Geometry fgeom = make_geom(amrex::refine(cdomain, ratio));
+
+    const int ncomp = 2;
+    const Box fine_region(IntVect(10), IntVect(13));
+    FArrayBox crse(quartic_interp.CoarseBox(fine_region, ratio), ncomp);
+    fill_coarse(crse);
+    FArrayBox fine(fine_region, ncomp);
+    quartic_interp.interp(crse, 0, fine, 0, ncomp, fine_region, ratio, cgeom, fgeom,
+                          make_bcr(ncomp), 0, 0, RunOn::Cpu);
+
+    AMREX_ALWAYS_ASSERT(fine.size() == sizeof(quartic_ref)/sizeof(quartic_ref[0]));
+    FArrayBox ref(fine_region, ncomp);
+    std::copy(std::begin(quartic_ref), std::end(quartic_ref), ref.dataPtr());
+    const Long n = count_diff(fine, fine_region, ref.const_array());
+    amrex::Print() << "CellConservativeQuartic: " << n << " wrong values\n";
+    return (n != 0) ? 1 : 0;
+}
+
+#if (AMREX_SPACEDIM == 2)
+int test_quadratic ()
+{
+    const Box cdomain(IntVect(0), IntVect(15));
+    const Geometry cgeom = make_geom(cdomain);
+    const int ncomp = 2;
+
+    int nerrors = 0;
+    for (int c = 0; c < 2; ++c)
+    {
+        // An interior region, and one at the lower corner of the domain
+        // where the boundary conditions are used.
+        const Box fine_region = (c == 0) ? Box(IntVect(10), IntVect(13))
+                                         : Box(IntVect(0), IntVect(5,7));
+        const IntVect ratio = (c == 0) ? IntVect(2) : IntVect(2,4);
+        const Geometry fgeom = make_geom(amrex::refine(cdomain, ratio));
+        Vector<BCRec> bcr = make_bcr(ncomp);
+        if (c == 1) {
+            bcr[0].setLo(0, BCType::ext_dir);
+            bcr[0].setLo(1, BCType::hoextrap);
+            bcr[1].setLo(0, BCType::foextrap);
+            bcr[1].setLo(1, BCType::foextrap);
+        }
+
+        CellQuadratic interp;
+        FArrayBox crse(interp.CoarseBox(fine_region, ratio), ncomp);
+        fill_coarse(crse);
+        FArrayBox fine(fine_region, ncomp);
+        interp.interp(crse, 0, fine, 0, ncomp, fine_region, ratio, cgeom, fgeom,
+                      bcr, 0, 0, RunOn::Cpu);
+
+        const double* ref_begin = (c == 0) ? std::begin(quadratic_interior_ref)
+                                           : std::begin(quadratic_boundary_ref);
+        const double* ref_end = (c == 0) ? std::end(quadratic_interior_ref)
+                                         : std::end(quadratic_boundary_ref);
+        AMREX_ALWAYS_ASSERT(fine.size() == static_cast<Long>(ref_end - ref_begin));
+        FArrayBox ref(fine_region, ncomp);
+        std::copy(ref_begin, ref_end, ref.dataPtr());
+        const Long n = count_diff(fine, fine_region, ref.const_array());
+        amrex::Print() << "CellQuadratic, fine region " << fine_region << ": "
+                       << n << " wrong values\n";
+        if (n != 0) { ++nerrors; }
+    }
+    return nerrors;
+}
+#endif
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nerrors = test_cellconslin();
+        nerrors += test_quartic();
+#if (AMREX_SPACEDIM == 2)
+        nerrors += test_quadratic();
+#endif
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "Interpolated values differ from the reference");
+    }
+    amrex::Finalize();
+}
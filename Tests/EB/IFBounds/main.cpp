@@ -0,0 +1,156 @@
+//
+// Checks the bounds of composite implicit functions (Union, Intersection,
+// Difference, Complement, Translation, Rotation and Scale of spheres,
+// boxes, planes and cylinders) on random boxes of nodes.  The bounds must
+// contain the values at all nodes, and the box type found by
+// EB2::GeometryShop with the bounds must be the one given by the signs of
+// the values at the nodes.
+//
+
+#include <AMReX.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_EB2_GeometryShop.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <limits>
+#include <random>
+
+using namespace amrex;
+
+namespace {
+
+// The box type from the values of f at all nodes of bx, as in
+// EB2::GeometryShop without bounds.  The range of the values is returned
+// in vmin and vmax.
+template <class F>
+int node_box_type (F const& f, const Box& bx, const Geometry& geom, Real& vmin, Real& vmax)
+{
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    bool has_body = false, has_fluid = false;
+    vmin = std::numeric_limits<Real>::max();
+    vmax = std::numeric_limits<Real>::lowest();
+    amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+    {
+        amrex::ignore_unused(j,k);
+        const Real v = f(RealArray{AMREX_D_DECL(problo[0]+i*dx[0],
+                                                problo[1]+j*dx[1],
+                                                problo[2]+k*dx[2])});
+        vmin = amrex::min(vmin, v);
+        vmax = amrex::max(vmax, v);
+        if (v > 0.0) {
+            has_body = true;
+        } else if (v < 0.0) {
+            has_fluid = true;
+        }
+    });
+    using GS = EB2::GeometryShop<F>;
+    if (!has_body) {
+        return GS::allregular;
+    } else if (!has_fluid) {
+        return GS::allcovered;
+    } else {
+        return GS::mixedcells;
+    }
+}
+
+template <class F>
+int check (const std::string& name, F const& f, const Vector<Box>& boxes, const Geometry& geom)
+{
+    static_assert(EB2::HasIFBounds<F>::value, "The implicit function has no bounds");
+
+    EB2::GeometryShop<F> gshop(f);
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    Long nmixed = 0, nwrong_type = 0, nwrong_bounds = 0;
+    for (auto const& bx : boxes)
+    {
+        Real vmin, vmax;
+        const int type = node_box_type(f, bx, geom, vmin, vmax);
+        if (type == EB2::GeometryShop<F>::mixedcells) { ++nmixed; }
+        if (gshop.getBoxType(bx, geom, RunOn::Cpu) != type) { ++nwrong_type; }
+
+        RealArray lo, hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            lo[idim] = problo[idim] + bx.smallEnd(idim)*dx[idim];
+            hi[idim] = problo[idim] + bx.bigEnd(idim)*dx[idim];
+        }
+        const EB2::IFBounds b = f.bounds(lo, hi);
+        if (b.lo > vmin || b.hi < vmax) { ++nwrong_bounds; }
+    }
+    amrex::Print() << name << ": " << boxes.size() << " boxes, " << nmixed << " mixed, "
+                   << nwrong_type << " with the wrong type, "
+                   << nwrong_bounds << " with wrong bounds\n";
+    return (nwrong_type != 0 || nwrong_bounds != 0) ? 1 : 0;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_box_size = 40;
+        int n_boxes = 1000;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_box_size", max_box_size);
+            pp.query("n_boxes", n_boxes);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        const Geometry geom(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+
+        // Boxes of nodes of random position and size, some of which are
+        // partly outside the domain.
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> ulo(-max_box_size/2, n_cell);
+        std::uniform_int_distribution<int> ulen(1, max_box_size);
+        Vector<Box> boxes;
+        for (int n = 0; n < n_boxes; ++n) {
+            IntVect lo, hi;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                lo[idim] = ulo(gen);
+                hi[idim] = lo[idim] + ulen(gen) - 1;
+            }
+            boxes.push_back(Box(lo, hi, IndexType::TheNodeType()));
+        }
+
+        const RealArray center{AMREX_D_DECL(0.5,0.5,0.5)};
+        EB2::SphereIF sphere(0.3, center, false);
+        EB2::BoxIF box({AMREX_D_DECL(0.2,0.3,0.25)}, {AMREX_D_DECL(0.7,0.6,0.8)}, false);
+        EB2::CylinderIF cylinder(0.15, 0.6, 1, center, false);
+        EB2::CylinderIF pipe(0.1, 0, center, true);
+        EB2::PlaneIF plane(center, {AMREX_D_DECL(0.3,-0.5,0.8)}, false);
+
+        int nerrors = 0;
+        nerrors += check("Union", EB2::makeUnion(sphere, cylinder, box), boxes, geom);
+        nerrors += check("Intersection", EB2::makeIntersection(sphere, plane, pipe), boxes, geom);
+        nerrors += check("Difference", EB2::makeDifference(box, cylinder), boxes, geom);
+        nerrors += check("Complement", EB2::makeComplement(EB2::makeUnion(sphere, box)),
+                         boxes, geom);
+        nerrors += check("Translation", EB2::translate(box, {AMREX_D_DECL(0.1,-0.2,0.05)}),
+                         boxes, geom);
+        nerrors += check("Scale", EB2::scale(sphere, {AMREX_D_DECL(1.5,0.5,0.8)}), boxes, geom);
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            nerrors += check("Rotation about " + std::to_string(dir),
+                             EB2::rotate(EB2::makeDifference(box, sphere), 0.6, dir),
+                             boxes, geom);
+        }
+        nerrors += check("Nested",
+                         EB2::translate(EB2::rotate(EB2::scale(EB2::makeUnion(
+                             EB2::makeIntersection(box, plane),
+                             EB2::makeComplement(EB2::makeDifference(pipe, sphere))),
+                             {AMREX_D_DECL(0.7,1.2,0.9)}), -0.4, AMREX_SPACEDIM-1),
+                             {AMREX_D_DECL(0.05,0.1,-0.1)}),
+                         boxes, geom);
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "Box types from the bounds differ from those at the nodes");
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,153 @@
+//
+// Builds an EB2::IndexSpace, writes it with EB2::WriteIndexSpace, reads it
+// back with EB2::ReadIndexSpace and checks that all levels hold the same
+// data as the ones that were built.
+//
+
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+Real max_diff (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrow());
+    MultiFab::Copy(d, a, 0, 0, a.nComp(), a.nGrow());
+    MultiFab::Subtract(d, b, 0, 0, a.nComp(), a.nGrow());
+    Real r = 0.0;
+    for (int n = 0; n < d.nComp(); ++n) {
+        r = amrex::max(r, d.norm0(n, d.nGrow()));
+    }
+    return r;
+}
+
+Long count_flag_diff (const FabArray<EBCellFlagFab>& a, const FabArray<EBCellFlagFab>& b)
+{
+    Long r = 0;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        const auto fa = a.const_array(mfi);
+        const auto fb = b.const_array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), [&] (int i, int j, int k)
+        {
+            if (fa(i,j,k).getValue() != fb(i,j,k).getValue()) { ++r; }
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(r);
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int max_coarsening_level = 3;
+        std::string dir = "eb2_index_space";
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("max_coarsening_level", max_coarsening_level);
+            pp.query("index_space_dir", dir);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, CoordSys::cartesian, is_periodic);
+
+        EB2::SphereIF sphere(0.31, {AMREX_D_DECL(0.5,0.47,0.52)}, false);
+        auto gshop = EB2::makeShop(sphere);
+        EB2::Build(gshop, geom, max_coarsening_level, max_coarsening_level);
+        const EB2::IndexSpace* built = EB2::TopIndexSpace();
+
+        EB2::WriteIndexSpace(dir, "IndexSpaceIO");
+        AMREX_ALWAYS_ASSERT(EB2::ReadIndexSpace(dir, "IndexSpaceIO", geom,
+                                                max_coarsening_level, max_coarsening_level));
+        const EB2::IndexSpace* read = EB2::TopIndexSpace();
+        AMREX_ALWAYS_ASSERT(read != built);
+
+        // A different geometry hash must be rejected.
+        AMREX_ALWAYS_ASSERT(!EB2::ReadIndexSpace(dir, "SomethingElse", geom,
+                                                 max_coarsening_level, max_coarsening_level));
+
+        Real diff = 0.0;
+        Long nflags = 0;
+        for (int ilev = 0; ilev <= max_coarsening_level; ++ilev)
+        {
+            const Box domain = amrex::coarsen(geom.Domain(), 1 << ilev);
+            const Geometry& g = built->getGeometry(domain);
+            const EB2::Level& lb = built->getLevel(g);
+            const EB2::Level& lr = read->getLevel(g);
+
+            BoxArray ba(domain);
+            ba.maxSize(max_grid_size);
+            DistributionMapping dm(ba);
+            const int ng = 2;
+
+            FabArray<EBCellFlagFab> fb(ba, dm, 1, ng);
+            FabArray<EBCellFlagFab> fr(ba, dm, 1, ng);
+            lb.fillEBCellFlag(fb, g);
+            lr.fillEBCellFlag(fr, g);
+            const Long nf = count_flag_diff(fb, fr);
+
+            MultiFab vb(ba, dm, 1, ng), vr(ba, dm, 1, ng);
+            MultiFab cb(ba, dm, AMREX_SPACEDIM, ng), cr(ba, dm, AMREX_SPACEDIM, ng);
+            // Not all fill functions touch the ghost cells outside the domain.
+            vb.setVal(0.0); vr.setVal(0.0); cb.setVal(0.0); cr.setVal(0.0);
+            lb.fillVolFrac(vb, g);  lr.fillVolFrac(vr, g);
+            Real d = max_diff(vb, vr);
+            lb.fillCentroid(cb, g);  lr.fillCentroid(cr, g);
+            d = amrex::max(d, max_diff(cb, cr));
+            lb.fillBndryCent(cb, g);  lr.fillBndryCent(cr, g);
+            d = amrex::max(d, max_diff(cb, cr));
+            lb.fillBndryNorm(cb, g);  lr.fillBndryNorm(cr, g);
+            d = amrex::max(d, max_diff(cb, cr));
+            lb.fillBndryArea(vb, g);  lr.fillBndryArea(vr, g);
+            d = amrex::max(d, max_diff(vb, vr));
+
+            Array<MultiFab,AMREX_SPACEDIM> ab, ar, eb, er;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const BoxArray& fba = amrex::convert(ba, IntVect::TheDimensionVector(idim));
+                ab[idim].define(fba, dm, 1, ng);
+                ar[idim].define(fba, dm, 1, ng);
+                IntVect edge_type{1}; edge_type[idim] = 0;
+                eb[idim].define(amrex::convert(ba, edge_type), dm, 1, ng);
+                er[idim].define(amrex::convert(ba, edge_type), dm, 1, ng);
+                ab[idim].setVal(0.0); ar[idim].setVal(0.0);
+                eb[idim].setVal(0.0); er[idim].setVal(0.0);
+            }
+            lb.fillAreaFrac(amrex::GetArrOfPtrs(ab), g);
+            lr.fillAreaFrac(amrex::GetArrOfPtrs(ar), g);
+            lb.fillEdgeCent(amrex::GetArrOfPtrs(eb), g);
+            lr.fillEdgeCent(amrex::GetArrOfPtrs(er), g);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                d = amrex::max(d, max_diff(ab[idim], ar[idim]));
+                d = amrex::max(d, max_diff(eb[idim], er[idim]));
+            }
+
+            MultiFab lsb(amrex::convert(ba, IntVect::TheNodeVector()), dm, 1, 0);
+            MultiFab lsr(amrex::convert(ba, IntVect::TheNodeVector()), dm, 1, 0);
+            lb.fillLevelSet(lsb, g);
+            lr.fillLevelSet(lsr, g);
+            d = amrex::max(d, max_diff(lsb, lsr));
+
+            amrex::Print() << "Coarsening level " << ilev << ": " << nf
+                           << " different cell flags, max difference " << d << "\n";
+            nflags += nf;
+            diff = amrex::max(diff, d);
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nflags == 0 && diff == 0.0,
+                                         "The IndexSpace read back differs from the one built");
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,184 @@
+//
+// FillBoundary and ParallelCopy of MultiFabs around a sphere with the
+// fluid inside, so that the boxes at the corners of the periodic domain are
+// all covered, with fabarray.skip_covered_boxes off and on.  The results
+// must be the same, except in the cells that are filled from a covered box
+// when the flag is off.  With the flag on, these cells keep their old
+// values.
+//
+
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace amrex;
+
+namespace {
+
+constexpr Real old_value = -1.e30;
+
+struct Result
+{
+    Vector<int> covered;
+    MultiFab fb;
+    MultiFab pc;
+};
+
+Result run (const Geometry& geom, const BoxArray& ba, const DistributionMapping& dm,
+            int nghost, bool skip_covered_boxes)
+{
+    FabArrayBase::SkipCoveredBoxes = skip_covered_boxes;
+    auto factory = amrex::makeEBFabFactory(geom, ba, dm, {2,2,2}, EBSupport::basic);
+    AMREX_ALWAYS_ASSERT(bool(factory->coveredBoxes()) == skip_covered_boxes);
+
+    Result r;
+    auto const& flags = factory->getMultiEBCellFlagFab();
+    r.covered.resize(ba.size(), 0);
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi) {
+        if (flags[mfi].getType(mfi.validbox()) == FabType::covered) {
+            r.covered[mfi.index()] = 1;
+        }
+    }
+    ParallelDescriptor::ReduceIntMax(r.covered.data(), r.covered.size());
+    if (skip_covered_boxes) {
+        AMREX_ALWAYS_ASSERT(std::equal(r.covered.begin(), r.covered.end(),
+                                       factory->coveredBoxes()->begin()));
+    }
+
+    // The valid cells have values that depend on the cell and the box, so
+    // that it is known where a value comes from.
+    MultiFab src(ba, dm, 2, nghost, MFInfo(), *factory);
+    src.setVal(old_value);
+    for (MFIter mfi(src); mfi.isValid(); ++mfi) {
+        auto const& a = src.array(mfi);
+        const int box = mfi.index();
+        amrex::LoopOnCpu(mfi.validbox(), 2, [&] (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = std::sin(0.1*i + 0.2*j + 0.3*k + n) + box;
+        });
+    }
+
+    r.fb.define(ba, dm, 2, nghost, MFInfo(), *factory);
+    MultiFab::Copy(r.fb, src, 0, 0, 2, nghost);
+    r.fb.FillBoundary(geom.periodicity());
+
+    r.pc.define(ba, dm, 2, nghost, MFInfo(), *factory);
+    r.pc.setVal(old_value);
+    r.pc.ParallelCopy(src, 0, 0, 2, IntVect(0), IntVect(nghost), geom.periodicity());
+
+    return r;
+}
+
+// Index of the box whose valid cells have the data of cell p, or -1.
+int source_box (const BoxArray& ba, const Periodicity& period, const IntVect& p)
+{
+    for (const IntVect& s : period.shiftIntVect()) {
+        const auto& isects = ba.intersections(Box(p+s, p+s));
+        if (!isects.empty()) { return isects[0].first; }
+    }
+    return -1;
+}
+
+// Number of wrong values of on, given those of off.  A cell is skipped if
+// skipped(source box, destination box) is true.
+template <class F>
+Long count_wrong (const MultiFab& off, const MultiFab& on, const Periodicity& period,
+                  bool skip_valid, F const& skipped, Long& nskipped)
+{
+    Long r = 0;
+    const BoxArray& ba = on.boxArray();
+    for (MFIter mfi(on); mfi.isValid(); ++mfi) {
+        auto const& aoff = off.const_array(mfi);
+        auto const& aon = on.const_array(mfi);
+        const Box& vbx = mfi.validbox();
+        const int dst = mfi.index();
+        amrex::LoopOnCpu(mfi.fabbox(), [&] (int i, int j, int k)
+        {
+            const IntVect p(AMREX_D_DECL(i,j,k));
+            const int src = source_box(ba, period, p);
+            const bool skip = (skip_valid || !vbx.contains(p)) && src >= 0 && skipped(src, dst);
+            if (skip) { ++nskipped; }
+            for (int n = 0; n < on.nComp(); ++n) {
+                if (skip) {
+                    if (aon(i,j,k,n) != old_value || aoff(i,j,k,n) == old_value) { ++r; }
+                } else {
+                    if (aon(i,j,k,n) != aoff(i,j,k,n)) { ++r; }
+                }
+            }
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(r);
+    ParallelDescriptor::ReduceLongSum(nskipped);
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        int nghost = 2;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nghost", nghost);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        const Geometry geom(domain, rb, 0, {AMREX_D_DECL(1,1,1)});
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        const DistributionMapping dm(ba);
+
+        EB2::SphereIF sphere(0.34, {AMREX_D_DECL(0.5,0.5,0.5)}, true);
+        EB2::Build(EB2::makeShop(sphere), geom, 0, 0);
+
+        const bool skip_covered_boxes = FabArrayBase::SkipCoveredBoxes;
+        const Result off = run(geom, ba, dm, nghost, false);
+        const Result on = run(geom, ba, dm, nghost, true);
+        FabArrayBase::SkipCoveredBoxes = skip_covered_boxes;
+
+        const auto& covered = off.covered;
+        const Long ncovered = std::count(covered.begin(), covered.end(), 1);
+        amrex::Print() << ncovered << " of " << ba.size() << " boxes are all covered\n";
+        AMREX_ALWAYS_ASSERT(ncovered > 0 && ncovered < ba.size());
+
+        int nerrors = 0;
+        {
+            // Ghost cells are not filled from covered boxes.
+            Long nskipped = 0;
+            const Long n = count_wrong(off.fb, on.fb, geom.periodicity(), false,
+                                       [&] (int src, int) { return covered[src]; },
+                                       nskipped);
+            amrex::Print() << "FillBoundary: " << nskipped << " cells skipped, "
+                           << n << " wrong values\n";
+            if (n != 0 || nskipped == 0) { ++nerrors; }
+        }
+        {
+            // Cells are not copied from a covered box to another one.
+            Long nskipped = 0;
+            const Long n = count_wrong(off.pc, on.pc, geom.periodicity(), true,
+                                       [&] (int src, int dst) { return covered[src] && covered[dst]; },
+                                       nskipped);
+            amrex::Print() << "ParallelCopy: " << nskipped << " cells skipped, "
+                           << n << " wrong values\n";
+            if (n != 0 || nskipped == 0) { ++nerrors; }
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "The results with and without skip_covered_boxes differ");
+    }
+    amrex::Finalize();
+}
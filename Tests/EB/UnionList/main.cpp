@@ -0,0 +1,143 @@
+//
+// Checks EB2::UnionListIF of many spheres and many cylinders point by point
+// against the maximum of the objects, i.e., their EB2::UnionIF.  The value
+// must be the same wherever it is not negative, and negative elsewhere.
+//
+
+#include <AMReX.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace amrex;
+
+namespace {
+
+// Number of points where ul differs from the maximum of the objects f.
+// The points are on a lattice that extends beyond the region of ul.
+template <class F>
+Long count_errors (EB2::UnionListIF<F> const& ul, Vector<F> const& f,
+                   RealBox const& region, int n_pts)
+{
+    const Box bx(IntVect(0), IntVect(n_pts-1));
+    Long nerrors = 0;
+    amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+    {
+        amrex::ignore_unused(j,k);
+        RealArray p;
+        const int ijk[] = {AMREX_D_DECL(i,j,k)};
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            const Real len = region.length(idim);
+            p[idim] = region.lo(idim) - 0.1*len + (ijk[idim]+0.5)*(1.2*len/n_pts);
+        }
+        Real r = std::numeric_limits<Real>::lowest();
+        for (auto const& fi : f) {
+            r = amrex::max(r, fi(p));
+        }
+        const Real v = ul(p);
+        const Real vgpu = ul(AMREX_D_DECL(p[0],p[1],p[2]));
+        const bool ok = (r >= 0.0) ? (v == r) : (v < 0.0);
+        if (!ok || vgpu != v) {
+            ++nerrors;
+        }
+    });
+    return nerrors;
+}
+
+template <class F>
+Vector<RealBox> no_bboxes (Vector<F> const&) { return Vector<RealBox>(); }
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_objects = 512;
+        int n_pts = 48;
+        {
+            ParmParse pp;
+            pp.query("n_objects", n_objects);
+            pp.query("n_pts", n_pts);
+        }
+
+        const RealBox region({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        const Real rmax = 0.5/std::pow(static_cast<Real>(n_objects), 1.0/AMREX_SPACEDIM);
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<Real> u01(0.0, 1.0);
+
+        Vector<EB2::SphereIF> spheres;
+        Vector<RealBox> sphere_bboxes;
+        Vector<EB2::CylinderIF> cylinders;
+        Vector<RealBox> cylinder_bboxes;
+        for (int i = 0; i < n_objects; ++i)
+        {
+            RealArray c;
+            for (auto& x : c) { x = u01(gen); }
+            const Real r = rmax*(0.5 + u01(gen));
+            spheres.push_back(EB2::SphereIF(r, c, false));
+            sphere_bboxes.push_back(RealBox({AMREX_D_DECL(c[0]-r,c[1]-r,c[2]-r)},
+                                            {AMREX_D_DECL(c[0]+r,c[1]+r,c[2]+r)}));
+
+            const int dir = i % AMREX_SPACEDIM;
+            const Real h = 4.0*r;
+            cylinders.push_back(EB2::CylinderIF(r, h, dir, c, false));
+            RealBox bb = sphere_bboxes.back();
+            bb.setLo(dir, c[dir]-0.5*h);
+            bb.setHi(dir, c[dir]+0.5*h);
+            cylinder_bboxes.push_back(bb);
+        }
+
+        Long nerrors = 0;
+        {
+            auto ul = EB2::makeUnionList(spheres, sphere_bboxes, region);
+            const Long n = count_errors(ul, spheres, region, n_pts);
+            amrex::Print() << "Spheres with bounding boxes: " << n << " errors\n";
+            nerrors += n;
+        }
+        {
+            auto ul = EB2::makeUnionList(spheres, no_bboxes(spheres), region);
+            const Long n = count_errors(ul, spheres, region, n_pts);
+            amrex::Print() << "Spheres with IF bounds: " << n << " errors\n";
+            nerrors += n;
+        }
+        {
+            auto ul = EB2::makeUnionList(cylinders, cylinder_bboxes, region);
+            const Long n = count_errors(ul, cylinders, region, n_pts);
+            amrex::Print() << "Cylinders with bounding boxes: " << n << " errors\n";
+            nerrors += n;
+        }
+        {
+            auto ul = EB2::makeUnionList(cylinders, no_bboxes(cylinders), region);
+            const Long n = count_errors(ul, cylinders, region, n_pts);
+            amrex::Print() << "Cylinders with IF bounds: " << n << " errors\n";
+            nerrors += n;
+        }
+
+        // A few objects, where UnionIF itself can be used.
+        {
+            Vector<EB2::SphereIF> f(spheres.begin(), spheres.begin()+3);
+            auto ul = EB2::makeUnionList(f, no_bboxes(f), region, IntVect(4));
+            auto u = EB2::makeUnion(f[0], f[1], f[2]);
+            Long n = 0;
+            amrex::LoopOnCpu(Box(IntVect(0), IntVect(n_pts-1)), [&] (int i, int j, int k)
+            {
+                amrex::ignore_unused(j,k);
+                const RealArray p{AMREX_D_DECL(i*(1.0/n_pts), j*(1.0/n_pts), k*(1.0/n_pts))};
+                const Real r = u(p);
+                if ((r >= 0.0) ? (ul(p) != r) : (ul(p) >= 0.0)) { ++n; }
+            });
+            amrex::Print() << "Three spheres compared with UnionIF: " << n << " errors\n";
+            nerrors += n;
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "UnionListIF differs from the union of its objects");
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,157 @@
+//
+// Times RealDescriptor conversions between the native Real format and the
+// other IEEE formats, with the fast IEEE paths and with the generic
+// PD_fconvert path, and checks that both give the same bits.
+//
+
+#include <AMReX.H>
+#include <AMReX_FabConv.H>
+#include <AMReX_FPC.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace amrex;
+
+namespace {
+
+// Fill with random numbers of widely varying magnitude plus special values
+// (zeros, denormals, infinities, NaNs, and numbers that over- or underflow
+// in single precision).
+void init_data (Vector<Real>& a)
+{
+    const Real special[] = {Real(0.), -Real(0.), Real(1.), -Real(1.),
+                            std::numeric_limits<Real>::denorm_min(),
+                            -std::numeric_limits<Real>::min(),
+                            std::numeric_limits<Real>::max(),
+                            std::numeric_limits<Real>::infinity(),
+                            -std::numeric_limits<Real>::infinity(),
+                            std::numeric_limits<Real>::quiet_NaN(),
+                            Real(1.e-40), Real(1.e-30), Real(3.e38), Real(4.e38)};
+    const int nspecial = sizeof(special)/sizeof(Real);
+    for (Long i = 0; i < a.size(); ++i) {
+        if (i % 97 < nspecial) {
+            a[i] = special[i % 97];
+        } else {
+            a[i] = (amrex::Random()-Real(0.5)) * std::pow(Real(10.), Real(amrex::Random_int(60)) - 30);
+        }
+    }
+}
+
+struct Result
+{
+    double time_fast = 0.;
+    double time_generic = 0.;
+    bool same = true;
+};
+
+template <typename F>
+Result run (F&& f, char* out_fast, char* out_generic, std::size_t nbytes, int nrepeat)
+{
+    Result r;
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool fast = (pass == 0);
+        char* out = fast ? out_fast : out_generic;
+        RealDescriptor::SetFastIEEEConversion(fast);
+        f(out);  // warm up
+        double t = amrex::second();
+        for (int n = 0; n < nrepeat; ++n) {
+            f(out);
+        }
+        t = (amrex::second() - t) / nrepeat;
+        (fast ? r.time_fast : r.time_generic) = t;
+    }
+    RealDescriptor::SetFastIEEEConversion(true);
+    r.same = std::memcmp(out_fast, out_generic, nbytes) == 0;
+    return r;
+}
+
+void report (const std::string& name, const Result& r, std::size_t nbytes)
+{
+    const double mb = double(nbytes) / (1024.*1024.);
+    amrex::Print() << "  " << name << ": fast " << mb/r.time_fast << " MB/s, generic "
+                   << mb/r.time_generic << " MB/s, speedup " << r.time_generic/r.time_fast
+                   << (r.same ? "" : "  *** RESULTS DIFFER ***") << "\n";
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        Long n = 1L << 22;
+        int nrepeat = 5;
+        {
+            ParmParse pp;
+            pp.query("n", n);
+            pp.query("nrepeat", nrepeat);
+        }
+
+        Vector<Real> a(n);
+        init_data(a);
+
+        // Formats as found in plotfiles and checkpoints written on the
+        // other kind of machine, or in single precision.
+        const RealDescriptor& rd64 = FPC::Ieee64NormalRealDescriptor();
+        const RealDescriptor* rds[] = {&rd64, &FPC::Ieee32NormalRealDescriptor(),
+                                       &FPC::Native32RealDescriptor()};
+        const char* names[] = {"IEEE 64 normal order", "IEEE 32 normal order", "native IEEE 32"};
+
+        Vector<char> file_data(n*sizeof(Real));
+        Vector<char> out_fast(n*sizeof(Real));
+        Vector<char> out_generic(n*sizeof(Real));
+
+        int nfailed = 0;
+        amrex::Print() << "Converting " << n << " numbers:\n";
+        for (int i = 0; i < 3; ++i)
+        {
+            const RealDescriptor& rd = *rds[i];
+            if (rd == FPC::NativeRealDescriptor()) { continue; }
+
+            RealDescriptor::convertFromNativeFormat(file_data.data(), n, a.data(), rd);
+
+            // The native to single precision conversion has its own path,
+            // which the fast IEEE paths do not replace.
+            if (rd != FPC::Native32RealDescriptor()) {
+                Result r = run([&] (char* out) {
+                        RealDescriptor::convertFromNativeFormat(out, n, a.data(), rd);
+                    }, out_fast.data(), out_generic.data(), n*rd.numBytes(), nrepeat);
+                report(std::string("native -> ") + names[i], r, n*sizeof(Real));
+                nfailed += ! r.same;
+            }
+
+            Result r = run([&] (char* out) {
+                    RealDescriptor::convertToNativeFormat(reinterpret_cast<Real*>(out), n,
+                                                          file_data.data(), rd);
+                }, out_fast.data(), out_generic.data(), n*sizeof(Real), nrepeat);
+            report(std::string(names[i]) + " -> native", r, n*sizeof(Real));
+            nfailed += ! r.same;
+        }
+
+        // Fix denormals after the conversion.  This cannot be turned off
+        // again, so it goes last.
+        RealDescriptor::SetFixDenormals();
+        {
+            const RealDescriptor& rd = rd64;
+            RealDescriptor::convertFromNativeFormat(file_data.data(), n, a.data(), rd);
+            Result r = run([&] (char* out) {
+                    RealDescriptor::convertToNativeFormat(reinterpret_cast<Real*>(out), n,
+                                                          file_data.data(), rd);
+                }, out_fast.data(), out_generic.data(), n*sizeof(Real), nrepeat);
+            report(std::string(names[0]) + " -> native, fix denormals", r, n*sizeof(Real));
+            nfailed += ! r.same;
+        }
+
+        if (nfailed > 0) {
+            amrex::Abort("FabConvBenchmark: fast and generic conversions differ");
+        }
+    }
+    amrex::Finalize();
+}
@@ -76,6 +76,13 @@ MyTest::solvePoisson ()
             mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
         }
 #endif
+        if (use_amg) {
+            mlmg.setBottomSolver(MLMG::BottomSolver::amg);
+        }
+        if (use_fft) {
+            mlmg.setBottomSolver(MLMG::BottomSolver::fft);
+        }
+        mlmg.setFusedSmoothing(fused_smoothing);
 
         mlmg.solve(GetVecOfPtrs(solution), GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
     }
@@ -117,6 +124,13 @@ MyTest::solvePoisson ()
                 mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
             }
 #endif
+            if (use_amg) {
+                mlmg.setBottomSolver(MLMG::BottomSolver::amg);
+            }
+            if (use_fft) {
+                mlmg.setBottomSolver(MLMG::BottomSolver::fft);
+            }
+            mlmg.setFusedSmoothing(fused_smoothing);
 
             mlmg.solve({&solution[ilev]}, {&rhs[ilev]}, tol_rel, tol_abs);
         }
@@ -193,6 +207,10 @@ MyTest::solveABecLaplacian ()
             mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
         }
 #endif
+        if (use_amg) {
+            mlmg.setBottomSolver(MLMG::BottomSolver::amg);
+        }
+        mlmg.setFusedSmoothing(fused_smoothing);
 
         mlmg.solve(GetVecOfPtrs(solution), GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
     }
@@ -250,6 +268,10 @@ MyTest::solveABecLaplacian ()
                 mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
             }
 #endif
+            if (use_amg) {
+                mlmg.setBottomSolver(MLMG::BottomSolver::amg);
+            }
+            mlmg.setFusedSmoothing(fused_smoothing);
 
             mlmg.solve({&solution[ilev]}, {&rhs[ilev]}, tol_rel, tol_abs);
         }
@@ -335,6 +357,10 @@ MyTest::solveABecLaplacianInhomNeumann ()
             mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
         }
 #endif
+        if (use_amg) {
+            mlmg.setBottomSolver(MLMG::BottomSolver::amg);
+        }
+        mlmg.setFusedSmoothing(fused_smoothing);
 
         mlmg.solve(GetVecOfPtrs(solution), GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
     }
@@ -392,6 +418,10 @@ MyTest::solveABecLaplacianInhomNeumann ()
                 mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
             }
 #endif
+            if (use_amg) {
+                mlmg.setBottomSolver(MLMG::BottomSolver::amg);
+            }
+            mlmg.setFusedSmoothing(fused_smoothing);
 
             mlmg.solve({&solution[ilev]}, {&rhs[ilev]}, tol_rel, tol_abs);
         }
@@ -447,6 +477,9 @@ MyTest::readParameters ()
 #ifdef AMREX_USE_PETSC
     pp.query("use_petsc", use_petsc);
 #endif
+    pp.query("use_amg", use_amg);
+    pp.query("use_fft", use_fft);
+    pp.query("fused_smoothing", fused_smoothing);
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!(use_hypre && use_petsc),
                                      "use_hypre & use_petsc cannot be both true");
 }
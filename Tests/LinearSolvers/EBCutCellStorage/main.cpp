@@ -0,0 +1,167 @@
+//
+// Solves the same MLEBABecLap problem around a sphere with the cut cell
+// data of the EBFArrayBoxFactory stored densely (EBCutCellStorage::dense)
+// and sparsely (EBCutCellStorage::sparse), with homogeneous Neumann and
+// with Dirichlet boundaries on the EB.  The solutions, the face fluxes and
+// the EB fluxes must be the same.
+//
+
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MLEBABecLap.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <cmath>
+
+using namespace amrex;
+
+namespace {
+
+struct Result
+{
+    MultiFab phi;
+    Array<MultiFab,AMREX_SPACEDIM> flux;
+    MultiFab eb_flux;
+};
+
+Result solve (const Geometry& geom, const BoxArray& ba, const DistributionMapping& dm,
+              EBCutCellStorage storage, bool eb_dirichlet, int max_coarsening_level)
+{
+    auto factory = amrex::makeEBFabFactory(geom, ba, dm, {2,2,2}, EBSupport::full, storage);
+    AMREX_ALWAYS_ASSERT(factory->cutCellStorage() == storage);
+
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+
+    Result r;
+    r.phi.define(ba, dm, 1, 1, MFInfo(), *factory);
+    r.phi.setVal(0.0);
+    MultiFab rhs(ba, dm, 1, 0, MFInfo(), *factory);
+    MultiFab acoef(ba, dm, 1, 0, MFInfo(), *factory);
+    MultiFab phi_eb(ba, dm, 1, 0, MFInfo(), *factory);
+    Array<MultiFab,AMREX_SPACEDIM> bcoef;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const BoxArray& fba = amrex::convert(ba, IntVect::TheDimensionVector(idim));
+        bcoef[idim].define(fba, dm, 1, 0, MFInfo(), *factory);
+        r.flux[idim].define(fba, dm, 1, 0, MFInfo(), *factory);
+    }
+    r.eb_flux.define(ba, dm, 1, 0, MFInfo(), *factory);
+
+    for (MFIter mfi(rhs); mfi.isValid(); ++mfi)
+    {
+        auto const& rhsa = rhs.array(mfi);
+        auto const& aa = acoef.array(mfi);
+        auto const& phieb = phi_eb.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k)
+        {
+            amrex::ignore_unused(j,k);
+            const Real x = problo[0] + (i+0.5)*dx[0];
+            const Real y = (AMREX_SPACEDIM >= 2) ? problo[1] + (j+0.5)*dx[1] : 0.0;
+            rhsa(i,j,k) = std::sin(6.0*x) * std::cos(4.0*y);
+            aa(i,j,k) = 1.0 + x*y;
+            phieb(i,j,k) = 1.0 + 0.5*y;
+        });
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            auto const& bb = bcoef[idim].array(mfi);
+            amrex::LoopOnCpu(mfi.nodaltilebox(idim), [&] (int i, int j, int k)
+            {
+                amrex::ignore_unused(j,k);
+                bb(i,j,k) = 1.0 + 0.5*std::sin(0.3*i + 0.2*j + 0.1*k);
+            });
+        }
+    }
+
+    LPInfo info;
+    info.setMaxCoarseningLevel(max_coarsening_level);
+    MLEBABecLap mleb({geom}, {ba}, {dm}, info, {factory.get()});
+    mleb.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,LinOpBCType::Dirichlet,LinOpBCType::Dirichlet)},
+                     {AMREX_D_DECL(LinOpBCType::Dirichlet,LinOpBCType::Dirichlet,LinOpBCType::Dirichlet)});
+    mleb.setLevelBC(0, &r.phi);
+    mleb.setScalars(1.0, 1.0);
+    mleb.setACoeffs(0, acoef);
+    mleb.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoef));
+    if (eb_dirichlet) {
+        mleb.setEBDirichlet(0, phi_eb, 1.0);
+    }
+
+    MLMG mlmg(mleb);
+    mlmg.setMaxIter(100);
+    mlmg.setVerbose(0);
+    mlmg.solve({&r.phi}, {&rhs}, 1.e-10, 0.0);
+    mlmg.getFluxes({amrex::GetArrOfPtrs(r.flux)});
+    mlmg.getEBFluxes({&r.eb_flux});
+    return r;
+}
+
+// Number of values over the valid region that differ, where two NaNs
+// are the same value.
+Long count_diff (const MultiFab& a, const MultiFab& b)
+{
+    Long r = 0;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        auto const& fa = a.const_array(mfi);
+        auto const& fb = b.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), a.nComp(), [&] (int i, int j, int k, int n)
+        {
+            const Real va = fa(i,j,k,n);
+            const Real vb = fb(i,j,k,n);
+            if (va != vb && !(std::isnan(va) && std::isnan(vb))) { ++r; }
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(r);
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        int max_coarsening_level = 30;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("max_coarsening_level", max_coarsening_level);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        const Geometry geom(domain, rb, 0, {AMREX_D_DECL(0,0,0)});
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        const DistributionMapping dm(ba);
+
+        EB2::SphereIF sphere(0.27, {AMREX_D_DECL(0.45,0.52,0.48)}, false);
+        EB2::Build(EB2::makeShop(sphere), geom, 0, max_coarsening_level);
+
+        int nerrors = 0;
+        for (bool eb_dirichlet : {false, true})
+        {
+            const Result dense = solve(geom, ba, dm, EBCutCellStorage::dense,
+                                       eb_dirichlet, max_coarsening_level);
+            const Result sparse = solve(geom, ba, dm, EBCutCellStorage::sparse,
+                                        eb_dirichlet, max_coarsening_level);
+            Long n = count_diff(dense.phi, sparse.phi);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                n += count_diff(dense.flux[idim], sparse.flux[idim]);
+            }
+            n += count_diff(dense.eb_flux, sparse.eb_flux);
+            amrex::Print() << (eb_dirichlet ? "Dirichlet" : "Neumann") << " EB: "
+                           << n << " values differ between dense and sparse storage\n";
+            if (n != 0) { ++nerrors; }
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "The solves with dense and sparse cut cell storage differ");
+    }
+    amrex::Finalize();
+}
@@ -38,6 +38,8 @@ MyTest::solve ()
             linop.setSigma(ilev, sigma[ilev]);
         }
 
+        linop.setStencilStorage(stencil_memory_budget);
+
         MLMG mlmg(linop);
         mlmg.setMaxIter(max_iter);
         mlmg.setMaxFmgIter(max_fmg_iter);
@@ -74,6 +76,8 @@ MyTest::solve ()
 
             linop.setSigma(0, sigma[ilev]); // set solver's level 0 sigma.
 
+            linop.setStencilStorage(stencil_memory_budget);
+
             MLMG mlmg(linop);
             mlmg.setMaxIter(max_iter);
             mlmg.setMaxFmgIter(max_fmg_iter);
@@ -153,6 +157,8 @@ MyTest::readParameters ()
     pp.query("semicoarsening", semicoarsening);
     pp.query("max_coarsening_level", max_coarsening_level);
     pp.query("max_semicoarsening_level", max_semicoarsening_level);
+
+    pp.query("stencil_memory_budget", stencil_memory_budget);
 }
 
 void
@@ -19,6 +19,32 @@ MyTest::MyTest ()
 
 void
 MyTest::solve ()
+{
+    MultiFab initial_guess;
+    if (compare_unfused) {
+        initial_guess.define(grids, dmap, AMREX_SPACEDIM, 1);
+        MultiFab::Copy(initial_guess, solution, 0, 0, AMREX_SPACEDIM, 1);
+    }
+
+    solve(solution, fused_smoothing);
+
+    // The fused smoothing must not change the result.
+    if (compare_unfused) {
+        solve(initial_guess, false);
+
+        MultiFab::Subtract(initial_guess, solution, 0, 0, AMREX_SPACEDIM, 0);
+        Real diff = 0.0;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            diff = amrex::max(diff, initial_guess.norm0(idim));
+        }
+        amrex::Print() << "\n  fused vs. unfused max difference = " << diff << std::endl;
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(diff == 0.0,
+                                         "Fused and unfused smoothing give different solutions");
+    }
+}
+
+void
+MyTest::solve (MultiFab& sol, bool fused)
 {
     std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc;
     std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc;
@@ -62,9 +88,10 @@ MyTest::solve ()
     MLMG mlmg(*mltensor);
     mlmg.setVerbose(verbose);
     mlmg.setBottomVerbose(bottom_verbose);
+    mlmg.setFusedSmoothing(fused);
 
     // In region with overset mask = 0, phi has valid solution and rhs is zero.
-    Real mlmg_err = mlmg.solve({&solution}, {&rhs}, 1.e-11, 0.0);
+    Real mlmg_err = mlmg.solve({&sol}, {&rhs}, 1.e-11, 0.0);
 }
 
 void
@@ -102,6 +129,8 @@ MyTest::readParameters ()
     pp.query("verbose", verbose);
     pp.query("bottom_verbose", bottom_verbose);
     pp.query("max_coarsening_level", max_coarsening_level);
+    pp.query("fused_smoothing", fused_smoothing);
+    pp.query("compare_unfused", compare_unfused);
 
     pp.query("do_overset", do_overset);
 }
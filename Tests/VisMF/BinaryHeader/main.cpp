@@ -0,0 +1,135 @@
+//
+// Writes a MultiFab with the binary header version
+// (VisMF::Header::NoFabHeaderBinary_v1) and several numbers of files,
+// reads it back with VisMF::Read and checks the data and the records
+// read with VisMF::ReadHeader and VisMF::ReadFabRecords.
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+#include <AMReX_VisMF.H>
+
+#include <set>
+
+using namespace amrex;
+
+namespace {
+
+// Difference of b from a, which may have a different DistributionMapping.
+// The ghost cells are compared too, so the data must agree where the
+// boxes grown by the ghost cells overlap.
+Real max_diff (const MultiFab& a, const MultiFab& b)
+{
+    AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray() && a.nComp() == b.nComp() &&
+                        a.nGrowVect() == b.nGrowVect());
+    MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrow());
+    d.ParallelCopy(b, 0, 0, a.nComp(), a.nGrow(), a.nGrow());
+    MultiFab::Subtract(d, a, 0, 0, a.nComp(), a.nGrow());
+    Real r = 0.0;
+    for (int n = 0; n < d.nComp(); ++n) {
+        r = amrex::max(r, d.norm0(n, d.nGrow()));
+    }
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int ncomp = 3;
+        int nghost = 1;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nghost", nghost);
+        }
+
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, ncomp, nghost);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            auto const& a = mf.array(mfi);
+            amrex::LoopOnCpu(mfi.fabbox(), ncomp, [&] (int i, int j, int k, int n)
+            {
+                a(i,j,k,n) = std::sin(0.1*i + 0.2*j + 0.3*k + n);
+            });
+        }
+
+        const int nprocs = ParallelDescriptor::NProcs();
+        Vector<int> pmap(ba.size());
+        for (int i = 0; i < ba.size(); ++i) {
+            pmap[i] = (dm[i] + 1) % nprocs;
+        }
+        DistributionMapping dm_shifted(std::move(pmap));
+
+        VisMF::SetHeaderVersion(VisMF::Header::NoFabHeaderBinary_v1);
+
+        int nerrors = 0;
+        for (int nfiles : std::set<int>{1, std::min(2,nprocs), nprocs})
+        {
+            const std::string name = "vismf_v5_nfiles" + std::to_string(nfiles) + "/mf";
+            VisMF::SetNOutFiles(nfiles);
+            if (ParallelDescriptor::IOProcessor()) {
+                amrex::UtilCreateDirectory(name.substr(0, name.find('/')), 0755);
+            }
+            ParallelDescriptor::Barrier();
+            VisMF::Write(mf, name);
+
+            // Read with a new DistributionMapping.
+            MultiFab mf_new;
+            VisMF::Read(mf_new, name);
+            const Real d_new = max_diff(mf, mf_new);
+
+            // Read into a MultiFab whose FABs are all on other processes.
+            MultiFab mf_shifted(ba, dm_shifted, ncomp, nghost);
+            VisMF::Read(mf_shifted, name);
+            const Real d_shifted = max_diff(mf, mf_shifted);
+
+            // The records of the local FABs, read on each process alone.
+            VisMF::Header hdr;
+            VisMF::ReadHeader(name, hdr);
+            AMREX_ALWAYS_ASSERT(hdr.m_vers == VisMF::Header::NoFabHeaderBinary_v1);
+            AMREX_ALWAYS_ASSERT(hdr.m_ba == ba && hdr.m_ncomp == ncomp &&
+                                hdr.m_ngrow == mf.nGrowVect());
+            VisMF::ReadFabRecords(name, hdr, mf.IndexArray());
+            Long nbad = 0;
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                const int idx = mfi.index();
+                for (int n = 0; n < ncomp; ++n) {
+                    if (hdr.m_min[idx][n] != mf[mfi].min<RunOn::Host>(mfi.validbox(), n) ||
+                        hdr.m_max[idx][n] != mf[mfi].max<RunOn::Host>(mfi.validbox(), n)) {
+                        ++nbad;
+                    }
+                }
+            }
+            for (int n = 0; n < ncomp; ++n) {
+                if (hdr.m_famin[n] != mf.min(n) || hdr.m_famax[n] != mf.max(n)) {
+                    ++nbad;
+                }
+            }
+            ParallelDescriptor::ReduceLongSum(nbad);
+
+            amrex::Print() << "nfiles = " << nfiles << ": max difference " << d_new
+                           << " (new layout), " << d_shifted << " (shifted layout), "
+                           << nbad << " wrong min/max values\n";
+            if (d_new != 0.0 || d_shifted != 0.0 || nbad != 0) {
+                ++nerrors;
+            }
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "The MultiFab read back differs from the one written");
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,162 @@
+//
+// Writes a MultiFab with VisMF::WriteDelta, first in full and then twice
+// as a delta of the previous one after some FABs have changed.  Each one
+// is read back with VisMF::Read and compared with the data written, and
+// the headers are checked to refer to the right data files.
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+#include <AMReX_VisMF.H>
+
+using namespace amrex;
+
+namespace {
+
+// Difference of b from a, FAB by FAB including the ghost cells, which
+// differ where the FABs grown by the ghost cells overlap.
+Real max_diff (const MultiFab& a, const MultiFab& b)
+{
+    AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray() && a.DistributionMap() == b.DistributionMap() &&
+                        a.nComp() == b.nComp() && a.nGrowVect() == b.nGrowVect());
+    Real r = 0.0;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        auto const& fa = a.const_array(mfi);
+        auto const& fb = b.const_array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), a.nComp(), [&] (int i, int j, int k, int n)
+        {
+            r = amrex::max(r, std::abs(fa(i,j,k,n) - fb(i,j,k,n)));
+        });
+    }
+    ParallelDescriptor::ReduceRealMax(r);
+    return r;
+}
+
+std::string write_delta (const MultiFab& mf, int step, const std::string& prev_name)
+{
+    const std::string dir = "delta" + std::to_string(step);
+    if (ParallelDescriptor::IOProcessor()) {
+        amrex::UtilCreateDirectory(dir, 0755);
+    }
+    ParallelDescriptor::Barrier();
+    VisMF::WriteDelta(mf, dir + "/mf", prev_name);
+    ParallelDescriptor::Barrier();
+    return dir + "/mf";
+}
+
+// Number of errors in the data read back from name and in the files the
+// FABs are read from.  FAB k must be in the data of step src_step[k].
+int check (const MultiFab& mf, const std::string& name, const Vector<int>& src_step)
+{
+    MultiFab mf_read(mf.boxArray(), mf.DistributionMap(), mf.nComp(), mf.nGrowVect());
+    VisMF::Read(mf_read, name);
+    const Real d = max_diff(mf, mf_read);
+
+    VisMF::Header hdr;
+    VisMF::ReadHeader(name, hdr);
+    // A file name without a directory is in the directory of name.
+    const std::string own_dir = name.substr(0, name.find('/')+1);
+    int nbad = 0;
+    for (int k = 0; k < mf.size(); ++k) {
+        const std::string& file = hdr.m_fod[k].m_name;
+        const std::string dir = "delta" + std::to_string(src_step[k]) + "/";
+        const std::string where = (file.find('/') == std::string::npos) ? own_dir : file;
+        if (where.find(dir) == std::string::npos) {
+            ++nbad;
+        }
+    }
+    if (hdr.m_hash.size() != mf.size()) {
+        ++nbad;
+    }
+
+    amrex::Print() << name << ": max difference " << d << ", "
+                   << nbad << " FABs in the wrong files\n";
+    return (d != 0.0 || nbad != 0) ? 1 : 0;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int ncomp = 3;
+        int nghost = 1;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nghost", nghost);
+        }
+
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        AMREX_ALWAYS_ASSERT(ba.size() >= 3);
+
+        MultiFab mf(ba, dm, ncomp, nghost);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            auto const& a = mf.array(mfi);
+            amrex::LoopOnCpu(mfi.fabbox(), ncomp, [&] (int i, int j, int k, int n)
+            {
+                a(i,j,k,n) = std::sin(0.1*i + 0.2*j + 0.3*k + n);
+            });
+        }
+
+        int nerrors = 0;
+        Vector<int> src_step(ba.size(), 0);
+
+        // Everything is written, since there is nothing to refer to.
+        const std::string name0 = write_delta(mf, 0, "");
+        MultiFab mf0(ba, dm, ncomp, nghost);
+        MultiFab::Copy(mf0, mf, 0, 0, ncomp, nghost);
+        nerrors += check(mf, name0, src_step);
+
+        // Every third FAB changes.
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            if (mfi.index() % 3 == 1) {
+                mf[mfi].plus<RunOn::Host>(1.0);
+            }
+        }
+        for (int k = 0; k < ba.size(); ++k) {
+            if (k % 3 == 1) { src_step[k] = 1; }
+        }
+        const std::string name1 = write_delta(mf, 1, name0);
+        nerrors += check(mf, name1, src_step);
+
+        // The sign of a single value changes in another third of the FABs.
+        // Only the most significant bit of the data differs.  The FABs
+        // unchanged since step 0 still refer to the files of step 0.
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            if (mfi.index() % 3 == 2) {
+                auto const& a = mf.array(mfi);
+                const Box& bx = mfi.validbox();
+                const IntVect p = bx.smallEnd();
+                a(p) = -a(p);
+            }
+        }
+        for (int k = 0; k < ba.size(); ++k) {
+            if (k % 3 == 2) { src_step[k] = 2; }
+        }
+        const std::string name2 = write_delta(mf, 2, name1);
+        nerrors += check(mf, name2, src_step);
+
+        // Nothing changes.  Only the header is written.
+        const std::string name3 = write_delta(mf, 3, name2);
+        nerrors += check(mf, name3, src_step);
+
+        // The earlier data is still there.
+        std::fill(src_step.begin(), src_step.end(), 0);
+        nerrors += check(mf0, name0, src_step);
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(nerrors == 0,
+                                         "The MultiFab read back differs from the one written");
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,142 @@
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_FPC.H>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+using namespace amrex;
+
+namespace {
+
+// Copy the FABs of FabArray name that live in the data files of other
+// checkpoints into new data files next to it.  Its own data files are
+// left alone because later delta checkpoints may refer to them.
+int compact (const std::string& name)
+{
+    Vector<char> faHeader;
+    VisMF::ReadFAHeader(name, faHeader);
+    VisMF::Header hdr;
+    {
+        std::istringstream iss(std::string(faHeader.dataPtr(), faHeader.size() - 1),
+                               std::istringstream::in);
+        iss >> hdr;
+    }
+
+    Vector<int> foreign;
+    for (int k = 0; k < hdr.m_fod.size(); ++k) {
+        if (hdr.m_fod[k].m_name.find('/') != std::string::npos) {
+            foreign.push_back(k);
+        }
+    }
+    if (foreign.empty()) {
+        return 0;
+    }
+
+    if (hdr.m_vers != VisMF::Header::Version_v1 &&
+        ! (hdr.m_writtenRD == FPC::NativeRealDescriptor()))
+    {
+        amrex::Abort("fcompactcheckpoint: " + name + " is not in native format");
+    }
+
+    MultiFab mf;
+    VisMF::Read(mf, name, faHeader.dataPtr());
+
+    BoxList bl(mf.boxArray().ixType());
+    Vector<int> pmap;
+    for (int k : foreign) {
+        bl.push_back(mf.box(k));
+        pmap.push_back(mf.DistributionMap()[k]);
+    }
+    MultiFab cmf(BoxArray(std::move(bl)), DistributionMapping(std::move(pmap)),
+                 mf.nComp(), mf.nGrowVect(), MFInfo().SetAlloc(false));
+    for (MFIter mfi(cmf); mfi.isValid(); ++mfi) {
+        cmf.setFab(mfi, new FArrayBox(mf[foreign[mfi.index()]], amrex::make_alias, 0, mf.nComp()));
+    }
+
+    const std::string cname = name + "_C";
+    VisMF::SetHeaderVersion(static_cast<VisMF::Header::Version>(hdr.m_vers));
+    FArrayBox::setFormat(FABio::FAB_NATIVE);
+    VisMF::Write(cmf, cname);
+    ParallelDescriptor::Barrier("fcompactcheckpoint");
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        VisMF::Header chdr;
+        {
+            std::ifstream ifs(cname + "_H");
+            ifs >> chdr;
+        }
+        for (int j = 0; j < foreign.size(); ++j) {
+            hdr.m_fod[foreign[j]] = chdr.m_fod[j];
+        }
+        {
+            std::ofstream ofs(name + "_H", std::ios::out | std::ios::trunc);
+            ofs << hdr;
+            if ( ! ofs.good()) {
+                amrex::FileOpenFailed(name + "_H");
+            }
+        }
+        std::remove((cname + "_H").c_str());
+    }
+    ParallelDescriptor::Barrier("fcompactcheckpoint");
+
+    return foreign.size();
+}
+
+}
+
+void main_main()
+{
+    const int narg = amrex::command_argument_count();
+
+    if (narg == 0) {
+        amrex::Print()
+            << "\n"
+            << " Usage:\n"
+            << "      fcompactcheckpoint chkfile [FabArray ...]\n"
+            << "\n"
+            << " Description:\n"
+            << "      This program makes a delta checkpoint (amr.checkpoint_delta = 1)\n"
+            << "      self-contained by copying the FABs it refers to in earlier\n"
+            << "      checkpoints into its own directory.  Afterwards the earlier\n"
+            << "      checkpoints are no longer needed to restart from it.  The\n"
+            << "      FabArrays are those listed in chkfile/FabArrayHeaders.txt\n"
+            << "      unless given as paths relative to chkfile."
+            << std::endl;
+        return;
+    }
+
+    const auto& chkfile = amrex::get_command_argument(1);
+
+    Vector<std::string> mf_names;
+    for (int i = 2; i <= narg; ++i) {
+        mf_names.push_back(amrex::get_command_argument(i));
+    }
+    if (mf_names.empty()) {
+        Vector<char> buf;
+        ParallelDescriptor::ReadAndBcastFile(chkfile + "/FabArrayHeaders.txt", buf);
+        std::istringstream iss(std::string(buf.dataPtr()), std::istringstream::in);
+        std::string line;
+        while (std::getline(iss, line)) {
+            if ( ! line.empty()) {
+                mf_names.push_back(line);
+            }
+        }
+    }
+
+    for (auto const& n : mf_names) {
+        const int ncopied = compact(chkfile + "/" + n);
+        amrex::Print() << " " << n << ": " << ncopied << " FABs copied\n";
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::SetVerbose(0);
+    amrex::Initialize(argc, argv, false);
+    main_main();
+    amrex::Finalize();
+}